@@ -0,0 +1,69 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <drivers/display/ssd1351.h>
+
+// Keycap seen from above, run-length encoded RGB565. It is symmetric, so it looks
+// the same in every orientation: the panel comes up from a work item, so the
+// splash can be drawn before or after the stored orientation is applied
+static const uint8_t boot_splash_data[] = {
+    0x57, 0x00, 0x00, 0x17, 0x4A, 0x69, 0x0C, 0x00, 0x00, 0x1D, 0x4A, 0x69,
+    0x08, 0x00, 0x00, 0x04, 0x4A, 0x69, 0x15, 0x29, 0x45, 0x04, 0x4A, 0x69,
+    0x06, 0x00, 0x00, 0x02, 0x4A, 0x69, 0x1B, 0x29, 0x45, 0x02, 0x4A, 0x69,
+    0x05, 0x00, 0x00, 0x01, 0x4A, 0x69, 0x1D, 0x29, 0x45, 0x01, 0x4A, 0x69,
+    0x05, 0x00, 0x00, 0x01, 0x4A, 0x69, 0x1D, 0x29, 0x45, 0x01, 0x4A, 0x69,
+    0x04, 0x00, 0x00, 0x02, 0x4A, 0x69, 0x06, 0x29, 0x45, 0x0F, 0x07, 0xFF,
+    0x06, 0x29, 0x45, 0x02, 0x4A, 0x69, 0x03, 0x00, 0x00, 0x01, 0x4A, 0x69,
+    0x05, 0x29, 0x45, 0x13, 0x07, 0xFF, 0x05, 0x29, 0x45, 0x01, 0x4A, 0x69,
+    0x03, 0x00, 0x00, 0x01, 0x4A, 0x69, 0x04, 0x29, 0x45, 0x15, 0x07, 0xFF,
+    0x04, 0x29, 0x45, 0x01, 0x4A, 0x69, 0x03, 0x00, 0x00, 0x01, 0x4A, 0x69,
+    0x04, 0x29, 0x45, 0x15, 0x07, 0xFF, 0x04, 0x29, 0x45, 0x01, 0x4A, 0x69,
+    0x03, 0x00, 0x00, 0x01, 0x4A, 0x69, 0x03, 0x29, 0x45, 0x17, 0x07, 0xFF,
+    0x03, 0x29, 0x45, 0x01, 0x4A, 0x69, 0x03, 0x00, 0x00, 0x01, 0x4A, 0x69,
+    0x03, 0x29, 0x45, 0x17, 0x07, 0xFF, 0x03, 0x29, 0x45, 0x01, 0x4A, 0x69,
+    0x03, 0x00, 0x00, 0x01, 0x4A, 0x69, 0x03, 0x29, 0x45, 0x17, 0x07, 0xFF,
+    0x03, 0x29, 0x45, 0x01, 0x4A, 0x69, 0x03, 0x00, 0x00, 0x01, 0x4A, 0x69,
+    0x03, 0x29, 0x45, 0x17, 0x07, 0xFF, 0x03, 0x29, 0x45, 0x01, 0x4A, 0x69,
+    0x03, 0x00, 0x00, 0x01, 0x4A, 0x69, 0x03, 0x29, 0x45, 0x17, 0x07, 0xFF,
+    0x03, 0x29, 0x45, 0x01, 0x4A, 0x69, 0x03, 0x00, 0x00, 0x01, 0x4A, 0x69,
+    0x03, 0x29, 0x45, 0x17, 0x07, 0xFF, 0x03, 0x29, 0x45, 0x01, 0x4A, 0x69,
+    0x03, 0x00, 0x00, 0x01, 0x4A, 0x69, 0x03, 0x29, 0x45, 0x17, 0x07, 0xFF,
+    0x03, 0x29, 0x45, 0x01, 0x4A, 0x69, 0x03, 0x00, 0x00, 0x01, 0x4A, 0x69,
+    0x03, 0x29, 0x45, 0x17, 0x07, 0xFF, 0x03, 0x29, 0x45, 0x01, 0x4A, 0x69,
+    0x03, 0x00, 0x00, 0x01, 0x4A, 0x69, 0x03, 0x29, 0x45, 0x17, 0x07, 0xFF,
+    0x03, 0x29, 0x45, 0x01, 0x4A, 0x69, 0x03, 0x00, 0x00, 0x01, 0x4A, 0x69,
+    0x03, 0x29, 0x45, 0x17, 0x07, 0xFF, 0x03, 0x29, 0x45, 0x01, 0x4A, 0x69,
+    0x03, 0x00, 0x00, 0x01, 0x4A, 0x69, 0x03, 0x29, 0x45, 0x17, 0x07, 0xFF,
+    0x03, 0x29, 0x45, 0x01, 0x4A, 0x69, 0x03, 0x00, 0x00, 0x01, 0x4A, 0x69,
+    0x03, 0x29, 0x45, 0x17, 0x07, 0xFF, 0x03, 0x29, 0x45, 0x01, 0x4A, 0x69,
+    0x03, 0x00, 0x00, 0x01, 0x4A, 0x69, 0x03, 0x29, 0x45, 0x17, 0x07, 0xFF,
+    0x03, 0x29, 0x45, 0x01, 0x4A, 0x69, 0x03, 0x00, 0x00, 0x01, 0x4A, 0x69,
+    0x03, 0x29, 0x45, 0x17, 0x07, 0xFF, 0x03, 0x29, 0x45, 0x01, 0x4A, 0x69,
+    0x03, 0x00, 0x00, 0x01, 0x4A, 0x69, 0x03, 0x29, 0x45, 0x17, 0x07, 0xFF,
+    0x03, 0x29, 0x45, 0x01, 0x4A, 0x69, 0x03, 0x00, 0x00, 0x01, 0x4A, 0x69,
+    0x03, 0x29, 0x45, 0x17, 0x07, 0xFF, 0x03, 0x29, 0x45, 0x01, 0x4A, 0x69,
+    0x03, 0x00, 0x00, 0x01, 0x4A, 0x69, 0x04, 0x29, 0x45, 0x15, 0x07, 0xFF,
+    0x04, 0x29, 0x45, 0x01, 0x4A, 0x69, 0x03, 0x00, 0x00, 0x01, 0x4A, 0x69,
+    0x04, 0x29, 0x45, 0x15, 0x07, 0xFF, 0x04, 0x29, 0x45, 0x01, 0x4A, 0x69,
+    0x03, 0x00, 0x00, 0x01, 0x4A, 0x69, 0x05, 0x29, 0x45, 0x13, 0x07, 0xFF,
+    0x05, 0x29, 0x45, 0x01, 0x4A, 0x69, 0x03, 0x00, 0x00, 0x02, 0x4A, 0x69,
+    0x06, 0x29, 0x45, 0x0F, 0x07, 0xFF, 0x06, 0x29, 0x45, 0x02, 0x4A, 0x69,
+    0x04, 0x00, 0x00, 0x01, 0x4A, 0x69, 0x1D, 0x29, 0x45, 0x01, 0x4A, 0x69,
+    0x05, 0x00, 0x00, 0x01, 0x4A, 0x69, 0x1D, 0x29, 0x45, 0x01, 0x4A, 0x69,
+    0x05, 0x00, 0x00, 0x02, 0x4A, 0x69, 0x1B, 0x29, 0x45, 0x02, 0x4A, 0x69,
+    0x06, 0x00, 0x00, 0x04, 0x4A, 0x69, 0x15, 0x29, 0x45, 0x04, 0x4A, 0x69,
+    0x08, 0x00, 0x00, 0x1D, 0x4A, 0x69, 0x0C, 0x00, 0x00, 0x17, 0x4A, 0x69,
+    0x57, 0x00, 0x00,
+};
+
+const struct ssd1351_splash ssd1351_boot_splash = {
+    .width = 40,
+    .height = 40,
+    .background = 0x0000,
+    .rle = true,
+    .len = sizeof(boot_splash_data),
+    .data = boot_splash_data,
+};
@@ -2,13 +2,19 @@
 #include <zephyr/device.h>
 #include <zephyr/drivers/sensor.h>
 #include <zephyr/drivers/led.h>
+#include <zephyr/drivers/display.h>
 #include <zephyr/logging/log.h>
+#include <zephyr/pm/device.h>
+#include <lvgl.h>
+#include <zmk/display.h>
 #include <zmk/event_manager.h>
 #include <zmk/events/keycode_state_changed.h>
 #include <zmk/events/layer_state_changed.h>
 #include <math.h>
 #include <stdlib.h>
 
+#include "low_power.h"
+
 int random0to100()
 {
     return rand() % 101; // 0 to 100
@@ -46,8 +52,16 @@ LOG_MODULE_DECLARE(zmk, CONFIG_ZMK_LOG_LEVEL);
 #define SCREEN_IDLE_TIMEOUT_MS (CONFIG_DONGLE_SCREEN_IDLE_TIMEOUT_S * 1000)
 #define BRIGHTNESS_CHANGE_THRESHOLD 5
 
+#if IS_ENABLED(CONFIG_DONGLE_SCREEN_BRIGHTNESS_CONTRAST) || IS_ENABLED(CONFIG_DONGLE_SCREEN_SUSPEND_DISPLAY)
+static const struct device *display_dev = DEVICE_DT_GET(DT_CHOSEN(zephyr_display));
+#endif
+
+#if IS_ENABLED(CONFIG_DONGLE_SCREEN_BRIGHTNESS_CONTRAST)
+static bool contrast_blanked = false; // Set while brightness 0 keeps the display blanked
+#else
 static const struct device *pwm_leds_dev = DEVICE_DT_GET_ONE(pwm_leds);
 #define DISP_BL DT_NODE_CHILD_IDX(DT_NODELABEL(disp_bl))
+#endif
 
 static int64_t last_activity = 0;
 static uint8_t max_brightness = CONFIG_DONGLE_SCREEN_MAX_BRIGHTNESS;
@@ -88,7 +102,31 @@ static uint8_t clamp_brightness(int8_t value)
 
 static void apply_brightness(uint8_t value)
 {
+#if IS_ENABLED(CONFIG_DONGLE_SCREEN_BRIGHTNESS_CONTRAST)
+    // Contrast 0 still lights the panel faintly, so blank it instead.
+    // The contrast is lowered as well so that a resume does not flash the old level.
+    if (value == 0)
+    {
+        if (!contrast_blanked)
+        {
+            display_set_brightness(display_dev, 0);
+            display_blanking_on(display_dev);
+            contrast_blanked = true;
+        }
+    }
+    else
+    {
+        // Brightness is a percentage, the display API takes 0-255
+        display_set_brightness(display_dev, (value * UINT8_MAX) / 100);
+        if (contrast_blanked)
+        {
+            display_blanking_off(display_dev);
+            contrast_blanked = false;
+        }
+    }
+#else
     led_set_brightness(pwm_leds_dev, DISP_BL, value);
+#endif
     LOG_INF("Screen brightness set to %d", value);
 }
 
@@ -199,6 +237,57 @@ static bool should_screen_turn_on(uint8_t base_brightness, int8_t modifier)
     return (base_brightness + modifier) > min_brightness;
 }
 
+// --- Display suspend ---
+
+#if IS_ENABLED(CONFIG_DONGLE_SCREEN_SUSPEND_DISPLAY)
+
+static bool display_suspended = false;
+
+#if !IS_ENABLED(CONFIG_SSD1351_SHADOW_FB)
+// Without the shadow framebuffer the driver drops updates while suspended, so LVGL has to redraw
+static void redraw_work_handler(struct k_work *work)
+{
+    lv_obj_invalidate(lv_scr_act());
+}
+
+K_WORK_DEFINE(redraw_work, redraw_work_handler);
+#endif
+
+// Suspend the display once the screen is dark and resume it before it lights up again
+static void display_set_suspended(bool suspend)
+{
+    if (suspend == display_suspended)
+    {
+        return;
+    }
+
+    int rc = pm_device_action_run(display_dev, suspend ? PM_DEVICE_ACTION_SUSPEND : PM_DEVICE_ACTION_RESUME);
+    if (rc < 0)
+    {
+        LOG_WRN("Failed to %s the display: %d", suspend ? "suspend" : "resume", rc);
+        return;
+    }
+
+    display_suspended = suspend;
+    LOG_DBG("Display %s", suspend ? "suspended" : "resumed");
+
+#if !IS_ENABLED(CONFIG_SSD1351_SHADOW_FB)
+    if (!suspend)
+    {
+        k_work_submit_to_queue(zmk_display_work_q(), &redraw_work);
+    }
+#endif
+}
+
+#else
+
+static void display_set_suspended(bool suspend)
+{
+    ARG_UNUSED(suspend);
+}
+
+#endif // CONFIG_DONGLE_SCREEN_SUSPEND_DISPLAY
+
 // Threaded fade logic
 // Contains starting and target brightness levels to be animated
 struct fade_request_t
@@ -236,10 +325,19 @@ void fade_thread(void)
         if (k_msgq_get(&fade_msgq, &req, K_FOREVER) == 0)
         {
 
+            if (req.to > 0)
+            {
+                display_set_suspended(false);
+            }
+
             // Skip animation entirely if brightness difference is too small
             if (req.from == req.to || abs(req.to - req.from) <= 1)
             {
                 apply_brightness(req.to);
+                if (req.to == 0)
+                {
+                    display_set_suspended(true);
+                }
                 continue;
             }
 
@@ -276,6 +374,11 @@ void fade_thread(void)
             {
                 apply_brightness(req.to);
             }
+
+            if (req.to == 0)
+            {
+                display_set_suspended(true);
+            }
         }
     }
 }
@@ -283,7 +386,13 @@ void fade_thread(void)
 // Launch the fade thread with 768 bytes of stack, medium priority (6)
 // 512 was too small for logging, math (float, int), small loop, few stack-local variables
 // 768 is just a guess, optimization is possible, probably
-K_THREAD_DEFINE(fade_tid, 768, fade_thread, NULL, NULL, NULL, 6, 0, 0);
+// Suspending and resuming the display runs the driver's PM action on this thread, which needs more
+#if IS_ENABLED(CONFIG_DONGLE_SCREEN_SUSPEND_DISPLAY)
+#define FADE_THREAD_STACK_SIZE 1280
+#else
+#define FADE_THREAD_STACK_SIZE 768
+#endif
+K_THREAD_DEFINE(fade_tid, FADE_THREAD_STACK_SIZE, fade_thread, NULL, NULL, NULL, 6, 0, 0);
 
 // Function to submit a brightness fade request
 // Ensures that only the most recent fade request is applied by purging the queue first for changes in between animations
@@ -307,6 +416,9 @@ void set_screen_brightness(uint8_t value, bool ambient)
 #if CONFIG_DONGLE_SCREEN_IDLE_TIMEOUT_S > 0 || CONFIG_DONGLE_SCREEN_BRIGHTNESS_KEYBOARD_CONTROL
 // --- Brightness logic ---
 static bool screen_on = true;
+#if IS_ENABLED(CONFIG_DONGLE_SCREEN_LOW_POWER)
+static bool screen_low_power = false; // Set while the idle screen shows the dimmed low power band
+#endif
 // --- Screen on/off ---
 
 static void screen_set_on(bool on)
@@ -321,13 +433,37 @@ static void screen_set_on(bool on)
             LOG_DBG("SCREEN TURN ON: Adjusted brightness to ensure screen can turn on: %d", current_brightness);
         }
 
-        fade_to_brightness(0, clamp_brightness(current_brightness + brightness_modifier));
+        uint8_t from = 0;
+#if IS_ENABLED(CONFIG_DONGLE_SCREEN_LOW_POWER)
+        if (screen_low_power)
+        {
+            low_power_set(false);
+            screen_low_power = false;
+            from = CONFIG_DONGLE_SCREEN_LOW_POWER_BRIGHTNESS;
+        }
+#endif
+
+        fade_to_brightness(from, clamp_brightness(current_brightness + brightness_modifier));
         screen_on = true;
         off_through_modifier = false; // Reset the flag, because the screen is turned on again
         LOG_INF("Screen on (smooth)");
     }
     else if (!on && screen_on)
     {
+#if IS_ENABLED(CONFIG_DONGLE_SCREEN_LOW_POWER)
+        // Only the idle timeout dims to the low power band, the toggle and modifier keys turn the screen off
+        if (!off_through_modifier)
+        {
+            uint8_t current_effective = clamp_brightness(current_brightness + brightness_modifier);
+
+            fade_to_brightness(current_effective, MIN(current_effective, CONFIG_DONGLE_SCREEN_LOW_POWER_BRIGHTNESS));
+            low_power_set(true);
+            screen_low_power = true;
+            screen_on = false;
+            LOG_INF("Screen low power (smooth)");
+            return;
+        }
+#endif
         fade_to_brightness(clamp_brightness(current_brightness + brightness_modifier), 0);
         screen_on = false;
         LOG_INF("Screen off (smooth)");
@@ -5,6 +5,7 @@
  */
 
 #include "custom_status_screen.h"
+#include "display_flush.h"
 
 #if CONFIG_DONGLE_SCREEN_OUTPUT_ACTIVE
 #include "widgets/output_status.h"
@@ -43,6 +44,8 @@ lv_obj_t *zmk_display_status_screen()
 {
     lv_obj_t *screen;
 
+    display_flush_init();
+
     screen = lv_obj_create(NULL);
     lv_obj_set_style_bg_color(screen, lv_color_hex(0x000000), LV_PART_MAIN);
     lv_obj_set_style_bg_opa(screen, 255, LV_PART_MAIN);
@@ -0,0 +1,177 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/device.h>
+#include <zephyr/drivers/display.h>
+#include <zephyr/logging/log.h>
+#include <drivers/display/ssd1351.h>
+#include <lvgl.h>
+
+#include "display_flush.h"
+#include "screen_rotate.h"
+
+LOG_MODULE_DECLARE(zmk, CONFIG_ZMK_LOG_LEVEL);
+
+static const struct device *const display_dev = DEVICE_DT_GET(DT_CHOSEN(zephyr_display));
+
+#ifdef CONFIG_DONGLE_SCREEN_RGB332
+BUILD_ASSERT(sizeof(lv_color_t) == 1, "RGB332 rendering needs LV_COLOR_DEPTH_8");
+
+// LVGL renders one byte per pixel, the driver expands it to RGB565 on the way
+// out and is done with the buffer when the write returns. The display is
+// switched to SSD1351_PIXEL_FORMAT_RGB_332 for that.
+static void rgb332_flush_cb(lv_disp_drv_t *disp_drv, const lv_area_t *area, lv_color_t *color_p)
+{
+    uint16_t w = lv_area_get_width(area);
+    uint16_t h = lv_area_get_height(area);
+    struct display_buffer_descriptor desc = {
+        .buf_size = w * h,
+        .width = w,
+        .height = h,
+        .pitch = w,
+    };
+
+    int ret = display_write(display_dev, area->x1, area->y1, &desc, color_p);
+    if (ret < 0)
+    {
+        LOG_WRN("RGB332 flush failed (%d)", ret);
+    }
+
+    lv_disp_flush_ready(disp_drv);
+}
+#endif
+
+#if defined(CONFIG_SSD1351_ASYNC_WRITE) && !defined(CONFIG_DONGLE_SCREEN_RGB332)
+// The driver owns the draw buffer until its pixels are on the wire, so LVGL
+// is told the flush is done from the SPI completion. With two draw buffers it
+// renders into the other one in the meantime.
+static void async_flush_done(const struct device *dev, int result, void *user_data)
+{
+    if (result < 0)
+    {
+        LOG_WRN("Async flush failed (%d)", result);
+    }
+
+    lv_disp_flush_ready(user_data);
+}
+
+static void async_flush_cb(lv_disp_drv_t *disp_drv, const lv_area_t *area, lv_color_t *color_p)
+{
+    uint16_t w = lv_area_get_width(area);
+    uint16_t h = lv_area_get_height(area);
+    struct display_buffer_descriptor desc = {
+        .buf_size = w * h * sizeof(lv_color_t),
+        .width = w,
+        .height = h,
+        .pitch = w,
+    };
+
+    int ret = display_write(display_dev, area->x1, area->y1, &desc, color_p);
+    if (ret < 0)
+    {
+        // Nothing was started, so no completion will come
+        LOG_WRN("Flush failed (%d)", ret);
+        lv_disp_flush_ready(disp_drv);
+    }
+}
+#endif
+
+#ifdef CONFIG_SSD1351_FRAME_HOLD_CS
+static void (*frame_next_flush_cb)(lv_disp_drv_t *disp_drv, const lv_area_t *area, lv_color_t *color_p);
+static bool frame_open;
+
+// One bus frame per LVGL refresh: CS goes down with the first area and only
+// comes back up after the last one
+static void frame_flush_cb(lv_disp_drv_t *disp_drv, const lv_area_t *area, lv_color_t *color_p)
+{
+    // lv_disp_flush_ready() clears the flag, so read it before flushing
+    bool last = lv_disp_flush_is_last(disp_drv);
+
+    if (!frame_open)
+    {
+        frame_open = ssd1351_frame_begin(display_dev) == 0;
+    }
+
+    frame_next_flush_cb(disp_drv, area, color_p);
+
+    if (frame_open && last)
+    {
+        int ret = ssd1351_frame_end(display_dev);
+        if (ret < 0)
+        {
+            LOG_WRN("Failed to end the display frame (%d)", ret);
+        }
+        frame_open = false;
+    }
+}
+#endif
+
+#ifdef CONFIG_SSD1351_DEFERRED_INIT
+static void (*panel_flush_cb)(lv_disp_drv_t *disp_drv, const lv_area_t *area, lv_color_t *color_p);
+
+// The panel comes up in the background while LVGL renders the first frame,
+// only its first flush has to wait for it
+static void first_flush_cb(lv_disp_drv_t *disp_drv, const lv_area_t *area, lv_color_t *color_p)
+{
+    int ret = ssd1351_wait_ready(display_dev, K_FOREVER);
+    if (ret < 0)
+    {
+        LOG_ERR("Display bring-up failed (%d)", ret);
+    }
+
+    disp_drv->flush_cb = panel_flush_cb;
+    panel_flush_cb(disp_drv, area, color_p);
+}
+#endif
+
+void display_flush_init(void)
+{
+    lv_disp_t *disp = lv_disp_get_default();
+
+    if (disp == NULL)
+    {
+        return;
+    }
+
+    // lvgl.c registered the display with the boot orientation as a rotation
+    // of its own, while the controller already rotates
+    disp_rotate_sync_lvgl(disp);
+
+#ifdef CONFIG_DONGLE_SCREEN_RGB332
+    // The default path for an RGB565 panel converts every pixel into 16 bit
+    // buffers through set_px_cb, which an 8 bit draw buffer can't hold
+    int ret = display_set_pixel_format(display_dev, SSD1351_PIXEL_FORMAT_RGB_332);
+    if (ret < 0)
+    {
+        LOG_ERR("Display does not take RGB332 (%d)", ret);
+    }
+    else
+    {
+        disp->driver->flush_cb = rgb332_flush_cb;
+        disp->driver->set_px_cb = NULL;
+    }
+#endif
+
+#if defined(CONFIG_SSD1351_ASYNC_WRITE) && !defined(CONFIG_DONGLE_SCREEN_RGB332)
+    // Without a callback the driver's writes wait for the transfer, so only
+    // with one does LVGL get to render while the pixels are sent
+    if (ssd1351_set_write_done_callback(display_dev, async_flush_done, disp->driver) == 0)
+    {
+        disp->driver->flush_cb = async_flush_cb;
+    }
+#endif
+
+#ifdef CONFIG_SSD1351_FRAME_HOLD_CS
+    frame_next_flush_cb = disp->driver->flush_cb;
+    disp->driver->flush_cb = frame_flush_cb;
+#endif
+
+#ifdef CONFIG_SSD1351_DEFERRED_INIT
+    panel_flush_cb = disp->driver->flush_cb;
+    disp->driver->flush_cb = first_flush_cb;
+#endif
+}
@@ -0,0 +1,13 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+/**
+ * @brief Install the shield's LVGL flush path on the default display
+ * Must run before the first refresh, i.e. while the status screen is built
+ */
+void display_flush_init(void);
@@ -0,0 +1,74 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/device.h>
+#include <zephyr/logging/log.h>
+#include <drivers/display/ssd1351.h>
+#include <lvgl.h>
+#include <zmk/display.h>
+
+#include "low_power.h"
+
+LOG_MODULE_DECLARE(zmk, CONFIG_ZMK_LOG_LEVEL);
+
+// The band runs along the controller's COM lines, the panel height
+BUILD_ASSERT(CONFIG_DONGLE_SCREEN_LOW_POWER_BAND_START + CONFIG_DONGLE_SCREEN_LOW_POWER_BAND_LINES <=
+                 DT_PROP(DT_CHOSEN(zephyr_display), height),
+             "The low power band must fit on the screen");
+
+static const struct device *const display_dev = DEVICE_DT_GET(DT_CHOSEN(zephyr_display));
+
+static bool low_power_target;
+static bool low_power_active;
+
+static void low_power_work_handler(struct k_work *work)
+{
+    lv_disp_t *disp = lv_disp_get_default();
+    bool enable = low_power_target;
+
+    if (enable == low_power_active)
+    {
+        return;
+    }
+
+    int ret = enable ? ssd1351_set_low_power(display_dev, CONFIG_DONGLE_SCREEN_LOW_POWER_BAND_START,
+                                             CONFIG_DONGLE_SCREEN_LOW_POWER_BAND_LINES)
+                     : ssd1351_set_low_power(display_dev, 0, 0);
+    if (ret < 0)
+    {
+        LOG_WRN("Failed to %s low power mode (%d)", enable ? "enter" : "leave", ret);
+        return;
+    }
+
+    low_power_active = enable;
+    LOG_DBG("Display low power mode %s", enable ? "on" : "off");
+
+    if (disp == NULL)
+    {
+        return;
+    }
+
+    // The driver only writes the band anyway, so there is no point refreshing often
+    lv_timer_set_period(disp->refr_timer, enable ? CONFIG_DONGLE_SCREEN_LOW_POWER_REFRESH_MS
+                                                 : CONFIG_LV_DISP_DEF_REFR_PERIOD);
+
+#if !IS_ENABLED(CONFIG_SSD1351_SHADOW_FB)
+    // Updates outside the band were dropped, redraw them
+    if (!enable)
+    {
+        lv_obj_invalidate(lv_scr_act());
+    }
+#endif
+}
+
+K_WORK_DEFINE(low_power_work, low_power_work_handler);
+
+void low_power_set(bool enable)
+{
+    low_power_target = enable;
+    k_work_submit_to_queue(zmk_display_work_q(), &low_power_work);
+}
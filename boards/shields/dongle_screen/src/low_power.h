@@ -0,0 +1,15 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include <stdbool.h>
+
+/**
+ * @brief Enter or leave the low power band mode
+ * Applied on the display work queue, between two LVGL refreshes
+ */
+void low_power_set(bool enable);
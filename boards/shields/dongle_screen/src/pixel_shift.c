@@ -0,0 +1,63 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/device.h>
+#include <zephyr/init.h>
+#include <zephyr/logging/log.h>
+#include <drivers/display/ssd1351.h>
+#include <zmk/display.h>
+#include <stdlib.h>
+
+LOG_MODULE_DECLARE(zmk, CONFIG_ZMK_LOG_LEVEL);
+
+static const struct device *const display_dev = DEVICE_DT_GET(DT_CHOSEN(zephyr_display));
+
+// Position on a triangle wave 0 .. MAX .. 0 .. -MAX .. 0
+static int pixel_shift_step;
+
+static void pixel_shift_work_handler(struct k_work *work);
+
+K_WORK_DELAYABLE_DEFINE(pixel_shift_work, pixel_shift_work_handler);
+
+// The controller moves the picture itself, nothing is rendered or flushed.
+// Runs on the display work queue, between two LVGL refreshes, instead of
+// holding up the system work queue while the display is busy.
+static void pixel_shift_work_handler(struct k_work *work)
+{
+    const int max = CONFIG_DONGLE_SCREEN_PIXEL_SHIFT_MAX;
+
+    pixel_shift_step = (pixel_shift_step + 1) % (4 * max);
+
+    int lines = pixel_shift_step <= 2 * max ? max - abs(pixel_shift_step - max)
+                                            : abs(pixel_shift_step - 3 * max) - max;
+
+    int ret = ssd1351_set_pixel_shift(display_dev, lines);
+    if (ret < 0)
+    {
+        LOG_WRN("Failed to shift the display (%d)", ret);
+    }
+
+    k_work_schedule_for_queue(zmk_display_work_q(), &pixel_shift_work,
+                              K_SECONDS(CONFIG_DONGLE_SCREEN_PIXEL_SHIFT_INTERVAL_S));
+}
+
+static int pixel_shift_init(void)
+{
+    if (!device_is_ready(display_dev))
+    {
+        return -ENODEV;
+    }
+
+    // The first step is a whole interval away, the display work queue is
+    // running by then
+    k_work_schedule_for_queue(zmk_display_work_q(), &pixel_shift_work,
+                              K_SECONDS(CONFIG_DONGLE_SCREEN_PIXEL_SHIFT_INTERVAL_S));
+
+    return 0;
+}
+
+SYS_INIT(pixel_shift_init, APPLICATION, CONFIG_APPLICATION_INIT_PRIORITY);
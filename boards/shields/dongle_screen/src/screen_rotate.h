@@ -0,0 +1,30 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include <zephyr/drivers/display.h>
+#include <lvgl.h>
+
+/**
+ * @brief Rotate the screen at runtime
+ * The controller remaps its addressing, LVGL is told the new resolution and
+ * redraws the whole screen once. Runs asynchronously on the display work queue.
+ */
+int disp_rotate(enum display_orientation orientation);
+
+/**
+ * @brief Rotate the screen by another 90 degrees
+ */
+int disp_rotate_next(void);
+
+/**
+ * @brief Tell LVGL the resolution of the current orientation
+ * The rotation is done by the controller, so LVGL must not rotate on its own.
+ * lvgl.c derives a rotation from the orientation set before it registered
+ * the display, which this undoes.
+ */
+void disp_rotate_sync_lvgl(lv_disp_t *disp);
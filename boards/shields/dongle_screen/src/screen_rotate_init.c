@@ -2,29 +2,55 @@
 #include <zephyr/device.h>
 #include <zephyr/drivers/display.h>
 #include <zephyr/logging/log.h>
+#include <lvgl.h>
+#include <zmk/display.h>
+#include <zmk/event_manager.h>
+#include <zmk/events/keycode_state_changed.h>
+
+#include "screen_rotate.h"
+
 LOG_MODULE_DECLARE(zmk, CONFIG_ZMK_LOG_LEVEL);
-int disp_set_orientation(void)
-{
-	// Set the orientation
-	const struct device *display = DEVICE_DT_GET(DT_CHOSEN(zephyr_display));
-	if (!device_is_ready(display))
-	{
-		return -EIO;
-	}
 
+#define DISP_ROTATE_INIT_PRIORITY 60
+
+// lvgl.c reads the resolution from the display capabilities when it registers
+// the display, so the controller has to be rotated before that
+BUILD_ASSERT(DISP_ROTATE_INIT_PRIORITY < CONFIG_APPLICATION_INIT_PRIORITY,
+			 "The orientation must be set before LVGL is initialized");
+
+static const struct device *const display = DEVICE_DT_GET(DT_CHOSEN(zephyr_display));
+
+// Orientation most recently requested, applied by the work below
+static enum display_orientation rotate_target;
+
+static enum display_orientation disp_default_orientation(void)
+{
 #ifdef CONFIG_DONGLE_SCREEN_HORIZONTAL
 #ifdef CONFIG_DONGLE_SCREEN_FLIPPED
-	int ret = display_set_orientation(display, DISPLAY_ORIENTATION_ROTATED_90);
+	return DISPLAY_ORIENTATION_ROTATED_90;
 #else
-	int ret = display_set_orientation(display, DISPLAY_ORIENTATION_ROTATED_270);
+	return DISPLAY_ORIENTATION_ROTATED_270;
 #endif
 #else
 #ifdef CONFIG_DONGLE_SCREEN_FLIPPED
-	int ret = display_set_orientation(display, DISPLAY_ORIENTATION_NORMAL);
+	return DISPLAY_ORIENTATION_NORMAL;
 #else
-	int ret = display_set_orientation(display, DISPLAY_ORIENTATION_ROTATED_180);
+	return DISPLAY_ORIENTATION_ROTATED_180;
 #endif
 #endif
+}
+
+int disp_set_orientation(void)
+{
+	// Set the orientation
+	if (!device_is_ready(display))
+	{
+		return -EIO;
+	}
+
+	rotate_target = disp_default_orientation();
+
+	int ret = display_set_orientation(display, rotate_target);
 
 	if (ret < 0)
 	{
@@ -34,4 +60,79 @@ int disp_set_orientation(void)
 	return 0;
 }
 
-SYS_INIT(disp_set_orientation, APPLICATION, 60);
\ No newline at end of file
+SYS_INIT(disp_set_orientation, APPLICATION, DISP_ROTATE_INIT_PRIORITY);
+
+void disp_rotate_sync_lvgl(lv_disp_t *disp)
+{
+	struct display_capabilities caps;
+
+	// The controller remap does the rotation, LVGL just renders at its resolution
+	display_get_capabilities(display, &caps);
+	disp->driver->hor_res = caps.x_resolution;
+	disp->driver->ver_res = caps.y_resolution;
+	disp->driver->rotated = LV_DISP_ROT_NONE;
+	disp->driver->sw_rotate = 0;
+
+	// Relayouts every screen and invalidates it, so the next refresh redraws everything
+	lv_disp_drv_update(disp, disp->driver);
+}
+
+// Runs on the display work queue, between two LVGL refreshes
+static void rotate_work_handler(struct k_work *work)
+{
+	lv_disp_t *disp = lv_disp_get_default();
+
+	int ret = display_set_orientation(display, rotate_target);
+	if (ret < 0)
+	{
+		LOG_ERR("Failed to rotate the display (%d)", ret);
+		return;
+	}
+
+	if (disp == NULL)
+	{
+		return;
+	}
+
+	disp_rotate_sync_lvgl(disp);
+}
+
+K_WORK_DEFINE(rotate_work, rotate_work_handler);
+
+int disp_rotate(enum display_orientation orientation)
+{
+	if (orientation > DISPLAY_ORIENTATION_ROTATED_270)
+	{
+		return -EINVAL;
+	}
+
+	rotate_target = orientation;
+	k_work_submit_to_queue(zmk_display_work_q(), &rotate_work);
+
+	return 0;
+}
+
+int disp_rotate_next(void)
+{
+	return disp_rotate((rotate_target + 1) % 4);
+}
+
+#if CONFIG_DONGLE_SCREEN_ROTATE_KEYCODE > 0
+
+static int rotate_key_listener(const zmk_event_t *eh)
+{
+	const struct zmk_keycode_state_changed *ev = as_zmk_keycode_state_changed(eh);
+
+	if (ev && ev->state && ev->keycode == CONFIG_DONGLE_SCREEN_ROTATE_KEYCODE)
+	{
+		LOG_INF("Rotate key recognized!");
+		disp_rotate_next();
+	}
+
+	return 0;
+}
+
+ZMK_LISTENER(screen_rotate, rotate_key_listener);
+ZMK_SUBSCRIPTION(screen_rotate, zmk_keycode_state_changed);
+
+#endif
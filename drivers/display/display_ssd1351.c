@@ -10,31 +10,218 @@
 
 #include <string.h>
 
+#include <drivers/display/ssd1351.h>
+
 #include <zephyr/device.h>
 #include <zephyr/drivers/display.h>
 #include <zephyr/drivers/gpio.h>
 #include <zephyr/drivers/spi.h>
 #include <zephyr/logging/log.h>
 #include <zephyr/pm/device.h>
+#include <zephyr/stats/stats.h>
+#include <zephyr/sys/byteorder.h>
 #include <zephyr/sys/util.h>
 
 LOG_MODULE_REGISTER(display_ssd1351, CONFIG_DISPLAY_LOG_LEVEL);
 
 struct ssd1351_config {
+  /* Its spi_config, at spi-max-frequency, is only used for the init table */
   struct spi_dt_spec bus;
+  uint32_t command_frequency;
+  uint32_t pixel_frequency;
   struct gpio_dt_spec cmd_data_gpio;
   struct gpio_dt_spec reset_gpio;
   uint16_t width;
   uint16_t height;
   uint16_t x_offset;
   uint16_t y_offset;
-  enum display_orientation default_orientation;
+  const uint8_t *init_cmds;
+  size_t init_cmds_len;
+  /* One entry per row of a strided write, sized for the longer panel side */
+  struct spi_buf *tx_bufs;
+  uint16_t tx_bufs_count;
+  /* tx_bufs_count pixels of one colour, repeated through tx_bufs on fills */
+  uint8_t *fill_row;
+#ifdef CONFIG_SSD1351_TILE_DIFF
+  struct ssd1351_tile *tiles;
+  uint16_t tiles_count;
+#endif
+#ifdef CONFIG_SSD1351_SHADOW_FB
+  /* width x height pixels in controller address order, as sent on the wire */
+  uint16_t *shadow_fb;
+#endif
+#ifdef CONFIG_SSD1351_RGB332
+  /* SSD1351_EXPAND_BUFS chunks of expanded RGB332 pixels */
+  uint8_t *expand_buf;
+#endif
+};
+
+/* Controller registers mirrored in RAM to skip writes that change nothing */
+enum ssd1351_reg {
+  SSD1351_REG_COLUMN,
+  SSD1351_REG_ROW,
+  SSD1351_REG_REMAP,
+  SSD1351_REG_STARTLINE,
+  SSD1351_REG_CONTRAST,
+  SSD1351_REG_DISPLAYOFFSET,
+  SSD1351_REG_CLOCKDIV,
+  SSD1351_REG_MUXRATIO,
+  SSD1351_REG_COUNT,
+};
+
+#define SSD1351_REG_MAX_LEN 3
+
+#ifdef CONFIG_SSD1351_TILE_DIFF
+#define SSD1351_TILE_SIZE CONFIG_SSD1351_TILE_DIFF_SIZE
+
+/*
+ * Last write that touched a tile: the covered part of the tile, in tile
+ * coordinates, and the hash of the pixels sent there. x0 == UINT8_MAX marks
+ * a tile without a known state.
+ */
+struct ssd1351_tile {
+  uint32_t hash;
+  uint8_t x0;
+  uint8_t y0;
+  uint8_t x1;
+  uint8_t y1;
+};
+#endif
+
+#ifdef CONFIG_SSD1351_STATS
+/* Bus traffic, plus a histogram of display_write() durations */
+STATS_SECT_START(ssd1351)
+STATS_SECT_ENTRY32(transactions)
+STATS_SECT_ENTRY32(commands)
+STATS_SECT_ENTRY32(param_bytes)
+STATS_SECT_ENTRY32(pixel_bytes)
+STATS_SECT_ENTRY32(writes)
+STATS_SECT_ENTRY32(fills)
+STATS_SECT_ENTRY32(errors)
+STATS_SECT_ENTRY32(write_lt_250us)
+STATS_SECT_ENTRY32(write_lt_1ms)
+STATS_SECT_ENTRY32(write_lt_4ms)
+STATS_SECT_ENTRY32(write_lt_16ms)
+STATS_SECT_ENTRY32(write_ge_16ms)
+STATS_SECT_END;
+
+STATS_NAME_START(ssd1351)
+STATS_NAME(ssd1351, transactions)
+STATS_NAME(ssd1351, commands)
+STATS_NAME(ssd1351, param_bytes)
+STATS_NAME(ssd1351, pixel_bytes)
+STATS_NAME(ssd1351, writes)
+STATS_NAME(ssd1351, fills)
+STATS_NAME(ssd1351, errors)
+STATS_NAME(ssd1351, write_lt_250us)
+STATS_NAME(ssd1351, write_lt_1ms)
+STATS_NAME(ssd1351, write_lt_4ms)
+STATS_NAME(ssd1351, write_lt_16ms)
+STATS_NAME(ssd1351, write_ge_16ms)
+STATS_NAME_END(ssd1351);
+
+#define SSD1351_STATS_INCN(data, var, n) STATS_INCN((data)->stats, var, n)
+#else
+#define SSD1351_STATS_INCN(data, var, n) ARG_UNUSED(data)
+#endif
+
+#define SSD1351_STATS_INC(data, var) SSD1351_STATS_INCN(data, var, 1)
+
+#ifdef CONFIG_SSD1351_DEFERRED_INIT
+/* Steps of the panel bring-up run from the system work queue */
+enum ssd1351_init_step {
+  SSD1351_INIT_RESET,
+  SSD1351_INIT_RELEASE,
+  SSD1351_INIT_PANEL,
 };
+#endif
 
 struct ssd1351_data {
+  /* Serialises the API, bus access within it is ordered by tx_idle */
+  struct k_mutex lock;
+  /*
+   * Copies of the bus configuration at the per-phase clocks. SPI drivers
+   * reconfigure when handed a different spi_config, so each phase keeps
+   * its own object.
+   */
+  struct spi_config cmd_spi_config;
+  struct spi_config pixel_spi_config;
+#ifdef CONFIG_SSD1351_FRAME_HOLD_CS
+  /*
+   * Used for everything between ssd1351_frame_begin() and _end(). The bus
+   * lock belongs to one spi_config, so a frame runs at a single clock.
+   */
+  struct spi_config frame_spi_config;
+  bool frame_active;
+  /* The bus is locked to frame_spi_config and needs releasing */
+  bool frame_locked;
+#endif
   uint16_t x_offset;
   uint16_t y_offset;
   enum display_orientation orientation;
+  /* Hardware scroll in GDDRAM rows, added to the start line and row addresses */
+  uint8_t scroll;
+  uint8_t brightness;
+  /* Picture shift along the COM axis, in the direction of a positive scroll */
+  int8_t pixel_shift;
+  /* Low power band along the scroll axis, band_lines is 0 outside of it */
+  uint8_t band_start;
+  uint8_t band_lines;
+  /* A write was cut to the band, the rows outside it are stale */
+  bool band_clipped;
+  /* Controller asleep and SPI bus suspended by the PM action */
+  bool suspended;
+  /* Panel switched off through the display API, kept across suspend */
+  bool blanked;
+#ifdef CONFIG_SSD1351_SHADOW_FB
+  /* The shadow holds pixels GDDRAM has not seen yet */
+  bool restore_pending;
+#endif
+#ifdef CONFIG_SSD1351_RGB332
+  /* display_write() takes SSD1351_PIXEL_FORMAT_RGB_332 instead of RGB565 */
+  bool rgb332;
+#endif
+  uint8_t regs[SSD1351_REG_COUNT][SSD1351_REG_MAX_LEN];
+  uint32_t regs_valid;
+  uint32_t elided_bytes;
+#ifdef CONFIG_SSD1351_STATS
+  STATS_SECT_DECL(ssd1351) stats;
+  /* Cycle count at the start of the display_write() in progress */
+  uint32_t write_start;
+#ifdef CONFIG_SSD1351_ASYNC_WRITE
+  /*
+   * write_start of the write whose last transfer is in flight. The next
+   * write stamps write_start before it waits for that transfer.
+   */
+  uint32_t tx_write_start;
+#endif
+#endif
+#ifdef CONFIG_SSD1351_TILE_DIFF
+  /* Set when GDDRAM may no longer match the tile hashes */
+  bool tiles_stale;
+  struct ssd1351_diff_stats diff_stats;
+#endif
+#if defined(CONFIG_SSD1351_ASYNC_WRITE) || defined(CONFIG_SSD1351_DEFERRED_INIT)
+  const struct device *dev;
+#endif
+#ifdef CONFIG_SSD1351_DEFERRED_INIT
+  struct k_work_delayable init_work;
+  enum ssd1351_init_step init_step;
+  /* Given once the panel is up, every waiter gives it back */
+  struct k_sem panel_up;
+  int init_result;
+#endif
+#ifdef CONFIG_SSD1351_ASYNC_WRITE
+  /* Taken by every bus access, given back by the async completion */
+  struct k_sem tx_idle;
+  /* Must outlive the call that starts the transfer */
+  struct spi_buf_set tx_buf_set;
+  int tx_result;
+  /* Only the last transfer of a display_write() reports completion */
+  bool tx_notify;
+  ssd1351_write_done_cb_t done_cb;
+  void *done_user_data;
+#endif
 };
 
 #define SSD1351_PIXEL_SIZE 2u
@@ -58,9 +245,81 @@ static void ssd1351_set_offsets(const struct device *dev, uint16_t x_offset,
                          ? DISPLAY_ORIENTATION_ROTATED_270                    \
                          : DISPLAY_ORIENTATION_NORMAL)
 
-static int ssd1351_transmit(const struct device *dev, uint8_t cmd,
-                            const uint8_t *tx_data, size_t tx_count) {
+#ifdef CONFIG_SSD1351_STATS
+static size_t ssd1351_buf_set_len(const struct spi_buf_set *tx) {
+  size_t len = 0U;
+
+  for (size_t i = 0U; i < tx->count; ++i) {
+    len += tx->buffers[i].len;
+  }
+
+  return len;
+}
+
+/* File a display_write() started at start and just completed */
+static void ssd1351_stats_write_done(struct ssd1351_data *data,
+                                     uint32_t start) {
+  uint32_t us = k_cyc_to_us_floor32(k_cycle_get_32() - start);
+
+  if (us < 250U) {
+    STATS_INC(data->stats, write_lt_250us);
+  } else if (us < 1000U) {
+    STATS_INC(data->stats, write_lt_1ms);
+  } else if (us < 4000U) {
+    STATS_INC(data->stats, write_lt_4ms);
+  } else if (us < 16000U) {
+    STATS_INC(data->stats, write_lt_16ms);
+  } else {
+    STATS_INC(data->stats, write_ge_16ms);
+  }
+}
+#endif
+
+static int ssd1351_bus_acquire(const struct device *dev) {
+#ifdef CONFIG_SSD1351_ASYNC_WRITE
+  struct ssd1351_data *data = dev->data;
+
+  k_sem_take(&data->tx_idle, K_FOREVER);
+#endif
+
+  return 0;
+}
+
+static void ssd1351_bus_release(const struct device *dev) {
+#ifdef CONFIG_SSD1351_ASYNC_WRITE
+  struct ssd1351_data *data = dev->data;
+
+  k_sem_give(&data->tx_idle);
+#endif
+}
+
+/*
+ * Bus configuration for the next transfer: the command or pixel one, or
+ * inside a frame the one holding CS and the bus lock.
+ */
+static const struct spi_config *ssd1351_spi_config(const struct device *dev,
+                                                   bool pixels) {
+  struct ssd1351_data *data = dev->data;
+
+#ifdef CONFIG_SSD1351_FRAME_HOLD_CS
+  if (data->frame_active) {
+    data->frame_locked = true;
+    return &data->frame_spi_config;
+  }
+#endif
+
+  return pixels ? &data->pixel_spi_config : &data->cmd_spi_config;
+}
+
+/*
+ * Send a command byte at the command clock, then the data in tx at the
+ * command clock for parameters or at the pixel clock for pixel data.
+ */
+static int ssd1351_transmit_set_locked(const struct device *dev, uint8_t cmd,
+                                       const struct spi_buf_set *tx,
+                                       bool pixels) {
   const struct ssd1351_config *config = dev->config;
+  struct ssd1351_data *data = dev->data;
   struct spi_buf buf = {
       .buf = (void *)&cmd,
       .len = 1,
@@ -75,24 +334,273 @@ static int ssd1351_transmit(const struct device *dev, uint8_t cmd,
     if (config->cmd_data_gpio.port != NULL) {
       gpio_pin_set_dt(&config->cmd_data_gpio, 1);
     }
-    ret = spi_write_dt(&config->bus, &buf_set);
+    ret = spi_write(config->bus.bus, ssd1351_spi_config(dev, false), &buf_set);
     if (ret < 0) {
       return ret;
     }
+    SSD1351_STATS_INC(data, transactions);
+    SSD1351_STATS_INC(data, commands);
   }
 
-  if ((tx_data != NULL) && (tx_count > 0U)) {
-    buf.buf = (void *)tx_data;
-    buf.len = tx_count;
+  if ((tx != NULL) && (tx->count > 0U)) {
     if (config->cmd_data_gpio.port != NULL) {
       gpio_pin_set_dt(&config->cmd_data_gpio, 0);
     }
-    ret = spi_write_dt(&config->bus, &buf_set);
+    ret = spi_write(config->bus.bus, ssd1351_spi_config(dev, pixels), tx);
+#ifdef CONFIG_SSD1351_STATS
+    if (ret == 0) {
+      STATS_INC(data->stats, transactions);
+      if (pixels) {
+        STATS_INCN(data->stats, pixel_bytes, ssd1351_buf_set_len(tx));
+      } else {
+        STATS_INCN(data->stats, param_bytes, ssd1351_buf_set_len(tx));
+      }
+    }
+#endif
+  }
+
+  return ret;
+}
+
+static int ssd1351_transmit_locked(const struct device *dev, uint8_t cmd,
+                                   const uint8_t *tx_data, size_t tx_count) {
+  struct spi_buf buf = {
+      .buf = (void *)tx_data,
+      .len = tx_count,
+  };
+  struct spi_buf_set buf_set = {
+      .buffers = &buf,
+      .count = 1,
+  };
+
+  return ssd1351_transmit_set_locked(
+      dev, cmd, ((tx_data != NULL) && (tx_count > 0U)) ? &buf_set : NULL,
+      false);
+}
+
+static int ssd1351_transmit(const struct device *dev, uint8_t cmd,
+                            const uint8_t *tx_data, size_t tx_count) {
+  int ret;
+
+  ssd1351_bus_acquire(dev);
+  ret = ssd1351_transmit_locked(dev, cmd, tx_data, tx_count);
+  ssd1351_bus_release(dev);
+
+  return ret;
+}
+
+#ifdef CONFIG_SSD1351_ASYNC_WRITE
+static void ssd1351_tx_done(const struct device *spi_dev, int result,
+                            void *user_data) {
+  struct ssd1351_data *data = user_data;
+  ssd1351_write_done_cb_t cb = data->done_cb;
+  bool notify = data->tx_notify;
+
+  ARG_UNUSED(spi_dev);
+
+  data->tx_result = result;
+  if (result < 0) {
+    data->regs_valid &= ~(BIT(SSD1351_REG_COLUMN) | BIT(SSD1351_REG_ROW));
+#ifdef CONFIG_SSD1351_TILE_DIFF
+    data->tiles_stale = true;
+#endif
+    SSD1351_STATS_INC(data, errors);
+  } else {
+    SSD1351_STATS_INC(data, transactions);
+    SSD1351_STATS_INCN(data, pixel_bytes,
+                       ssd1351_buf_set_len(&data->tx_buf_set));
+  }
+#ifdef CONFIG_SSD1351_STATS
+  if (notify) {
+    ssd1351_stats_write_done(data, data->tx_write_start);
+  }
+#endif
+  k_sem_give(&data->tx_idle);
+
+  if (notify && (cb != NULL)) {
+    cb(data->dev, result, data->done_user_data);
+  }
+}
+
+/*
+ * Start streaming pixel data and return without waiting for it. The caller
+ * holds the bus; on success it stays acquired until ssd1351_tx_done() runs,
+ * so the next access blocks on it.
+ */
+static int ssd1351_transmit_async_locked(const struct device *dev,
+                                         const struct spi_buf *bufs,
+                                         size_t count) {
+  const struct ssd1351_config *config = dev->config;
+  struct ssd1351_data *data = dev->data;
+
+  if (config->cmd_data_gpio.port != NULL) {
+    gpio_pin_set_dt(&config->cmd_data_gpio, 0);
+  }
+
+  data->tx_buf_set.buffers = bufs;
+  data->tx_buf_set.count = count;
+
+  return spi_transceive_cb(config->bus.bus, ssd1351_spi_config(dev, true),
+                           &data->tx_buf_set, NULL, ssd1351_tx_done, data);
+}
+#endif
+
+int ssd1351_set_write_done_callback(const struct device *dev,
+                                    ssd1351_write_done_cb_t cb,
+                                    void *user_data) {
+#ifdef CONFIG_SSD1351_ASYNC_WRITE
+  struct ssd1351_data *data = dev->data;
+  unsigned int key = irq_lock();
+
+  data->done_cb = cb;
+  data->done_user_data = user_data;
+  irq_unlock(key);
+
+  return 0;
+#else
+  ARG_UNUSED(dev);
+  ARG_UNUSED(cb);
+  ARG_UNUSED(user_data);
+
+  return -ENOTSUP;
+#endif
+}
+
+int ssd1351_wait_idle(const struct device *dev, k_timeout_t timeout) {
+#ifdef CONFIG_SSD1351_ASYNC_WRITE
+  struct ssd1351_data *data = dev->data;
+
+  if (k_sem_take(&data->tx_idle, timeout) < 0) {
+    return -EAGAIN;
+  }
+  k_sem_give(&data->tx_idle);
+
+  return data->tx_result;
+#else
+  ARG_UNUSED(dev);
+  ARG_UNUSED(timeout);
+
+  return 0;
+#endif
+}
+
+int ssd1351_frame_begin(const struct device *dev) {
+#ifdef CONFIG_SSD1351_FRAME_HOLD_CS
+  struct ssd1351_data *data = dev->data;
+  int ret = 0;
+
+  /*
+   * Only the bus is held across the frame. API calls still take the lock
+   * one at a time, and their commands go out inside the frame.
+   */
+  k_mutex_lock(&data->lock, K_FOREVER);
+  if (data->frame_active) {
+    ret = -EALREADY;
+  } else {
+    data->frame_active = true;
+  }
+  k_mutex_unlock(&data->lock);
+
+  return ret;
+#else
+  ARG_UNUSED(dev);
+
+  return -ENOTSUP;
+#endif
+}
+
+#ifdef CONFIG_SSD1351_FRAME_HOLD_CS
+/* Let go of CS and the bus lock of a frame, the caller holds the bus */
+static int ssd1351_frame_unlock_bus(const struct device *dev) {
+  const struct ssd1351_config *config = dev->config;
+  struct ssd1351_data *data = dev->data;
+
+  if (!data->frame_locked) {
+    return 0;
+  }
+
+  data->frame_locked = false;
+
+  return spi_release(config->bus.bus, &data->frame_spi_config);
+}
+#endif
+
+int ssd1351_frame_end(const struct device *dev) {
+#ifdef CONFIG_SSD1351_FRAME_HOLD_CS
+  struct ssd1351_data *data = dev->data;
+  int ret;
+
+  k_mutex_lock(&data->lock, K_FOREVER);
+
+  if (!data->frame_active) {
+    k_mutex_unlock(&data->lock);
+    return -EALREADY;
+  }
+
+  /* The last transfer of the frame may still be streaming */
+  ssd1351_bus_acquire(dev);
+  data->frame_active = false;
+  ret = ssd1351_frame_unlock_bus(dev);
+  ssd1351_bus_release(dev);
+
+  k_mutex_unlock(&data->lock);
+
+  return ret;
+#else
+  ARG_UNUSED(dev);
+
+  return -ENOTSUP;
+#endif
+}
+
+/*
+ * Write a mirrored register unless the shadow says the controller already
+ * holds the same value. Failed writes drop the shadow entry. The shadow is
+ * only read with the bus acquired: the completion of a transfer still in
+ * flight drops the window registers if it fails.
+ */
+static int ssd1351_set_reg(const struct device *dev, enum ssd1351_reg reg,
+                           uint8_t cmd, const uint8_t *params, size_t len) {
+  struct ssd1351_data *data = dev->data;
+  int ret;
+
+  __ASSERT(len <= SSD1351_REG_MAX_LEN, "Register too long for the shadow");
+
+  ssd1351_bus_acquire(dev);
+
+  if (((data->regs_valid & BIT(reg)) != 0U) &&
+      (memcmp(data->regs[reg], params, len) == 0)) {
+    data->elided_bytes += 1U + len;
+    ssd1351_bus_release(dev);
+    return 0;
+  }
+
+  ret = ssd1351_transmit_locked(dev, cmd, params, len);
+  if (ret < 0) {
+    data->regs_valid &= ~BIT(reg);
+  } else {
+    memcpy(data->regs[reg], params, len);
+    data->regs_valid |= BIT(reg);
   }
 
+  ssd1351_bus_release(dev);
+
   return ret;
 }
 
+static void ssd1351_invalidate_regs(const struct device *dev,
+                                    uint32_t reg_mask) {
+  struct ssd1351_data *data = dev->data;
+
+  data->regs_valid &= ~reg_mask;
+}
+
+uint32_t ssd1351_get_elided_bytes(const struct device *dev) {
+  const struct ssd1351_data *data = dev->data;
+
+  return data->elided_bytes;
+}
+
 static void ssd1351_reset(const struct device *dev) {
   const struct ssd1351_config *config = dev->config;
 
@@ -105,24 +613,103 @@ static void ssd1351_reset(const struct device *dev) {
   }
 }
 
+/*
+ * Wait for the deferred bring-up, see ssd1351_init(). Entry points that
+ * cannot act like the panel is suspended until then call this first.
+ */
+static int ssd1351_await_panel(const struct device *dev, k_timeout_t timeout) {
+#ifdef CONFIG_SSD1351_DEFERRED_INIT
+  struct ssd1351_data *data = dev->data;
+  int ret;
+
+  ret = k_sem_take(&data->panel_up, timeout);
+  if (ret < 0) {
+    return ret;
+  }
+  k_sem_give(&data->panel_up);
+
+  return data->init_result;
+#else
+  ARG_UNUSED(dev);
+  ARG_UNUSED(timeout);
+
+  return 0;
+#endif
+}
+
+int ssd1351_wait_ready(const struct device *dev, k_timeout_t timeout) {
+  return ssd1351_await_panel(dev, timeout);
+}
+
+/* Light the panel unless it was blanked through the display API */
+static int ssd1351_apply_blanking(const struct device *dev) {
+  const struct ssd1351_data *data = dev->data;
+
+  return ssd1351_transmit(dev,
+                          data->blanked ? SSD1351_CMD_DISPLAYOFF
+                                        : SSD1351_CMD_DISPLAYON,
+                          NULL, 0);
+}
+
+static int ssd1351_set_blanking(const struct device *dev, bool blanked) {
+  struct ssd1351_data *data = dev->data;
+  int ret;
+
+  k_mutex_lock(&data->lock, K_FOREVER);
+  data->blanked = blanked;
+  /* Resume applies it otherwise */
+  ret = data->suspended ? 0 : ssd1351_apply_blanking(dev);
+  k_mutex_unlock(&data->lock);
+
+  return ret;
+}
+
 static int ssd1351_blanking_on(const struct device *dev) {
-  return ssd1351_transmit(dev, SSD1351_CMD_DISPLAYOFF, NULL, 0);
+  return ssd1351_set_blanking(dev, true);
 }
 
 static int ssd1351_blanking_off(const struct device *dev) {
-  return ssd1351_transmit(dev, SSD1351_CMD_DISPLAYON, NULL, 0);
+  return ssd1351_set_blanking(dev, false);
+}
+
+static bool ssd1351_is_rotated(const struct device *dev) {
+  const struct ssd1351_data *data = dev->data;
+
+  return (data->orientation == DISPLAY_ORIENTATION_ROTATED_90) ||
+         (data->orientation == DISPLAY_ORIENTATION_ROTATED_270);
+}
+
+/*
+ * With a hardware scroll the rows of an area may wrap around the end of
+ * GDDRAM. Return how many of them, counted along the logical axis that maps
+ * to GDDRAM rows, fit before the wrap.
+ */
+static uint16_t ssd1351_rows_before_wrap(const struct device *dev, uint16_t x,
+                                         uint16_t y, uint16_t width,
+                                         uint16_t height) {
+  const struct ssd1351_data *data = dev->data;
+  bool rotated = ssd1351_is_rotated(dev);
+  uint16_t row = ((rotated ? x : y) + data->y_offset + data->scroll) %
+                 SSD1351_GDDRAM_ROWS;
+
+  return MIN(rotated ? width : height, SSD1351_GDDRAM_ROWS - row);
 }
 
-static void ssd1351_set_mem_area(const struct device *dev, uint16_t x,
-                                 uint16_t y, uint16_t w, uint16_t h) {
+/*
+ * Every write fills its window completely, which wraps the controller's
+ * address pointer back to the window origin. An unchanged window therefore
+ * needs no SETCOLUMN/SETROW before the next WRITERAM. The window must not
+ * wrap around the end of GDDRAM, see ssd1351_rows_before_wrap().
+ */
+static int ssd1351_set_mem_area(const struct device *dev, uint16_t x,
+                                uint16_t y, uint16_t w, uint16_t h) {
   struct ssd1351_data *data = dev->data;
   uint16_t x1 = x;
   uint16_t y1 = y;
   uint16_t x2 = x + w - 1;
   uint16_t y2 = y + h - 1;
 
-  if ((data->orientation == DISPLAY_ORIENTATION_ROTATED_90) ||
-      (data->orientation == DISPLAY_ORIENTATION_ROTATED_270)) {
+  if (ssd1351_is_rotated(dev)) {
     uint16_t tmp;
 
     tmp = x1;
@@ -135,45 +722,1292 @@ static void ssd1351_set_mem_area(const struct device *dev, uint16_t x,
 
   x1 += data->x_offset;
   x2 += data->x_offset;
-  y1 += data->y_offset;
-  y2 += data->y_offset;
+  y2 -= y1;
+  y1 = (y1 + data->y_offset + data->scroll) % SSD1351_GDDRAM_ROWS;
+  y2 += y1;
 
   uint8_t col_param[2] = {x1 & 0xFF, x2 & 0xFF};
   uint8_t row_param[2] = {y1 & 0xFF, y2 & 0xFF};
 
-  ssd1351_transmit(dev, SSD1351_CMD_SETCOLUMN, col_param, sizeof(col_param));
-  ssd1351_transmit(dev, SSD1351_CMD_SETROW, row_param, sizeof(row_param));
-}
+  int ret = ssd1351_set_reg(dev, SSD1351_REG_COLUMN, SSD1351_CMD_SETCOLUMN,
+                            col_param, sizeof(col_param));
+  if (ret < 0) {
+    return ret;
+  }
 
-static int ssd1351_write(const struct device *dev, uint16_t x, uint16_t y,
-                         const struct display_buffer_descriptor *desc,
-                         const void *buf) {
-  const uint8_t *write_data_start = buf;
-  uint16_t nbr_of_writes;
-  uint16_t write_h;
+  return ssd1351_set_reg(dev, SSD1351_REG_ROW, SSD1351_CMD_SETROW, row_param,
+                         sizeof(row_param));
+}
 
-  __ASSERT(desc->width <= desc->pitch, "Pitch is smaller then width");
-  __ASSERT((desc->pitch * SSD1351_PIXEL_SIZE * desc->height) <= desc->buf_size,
-           "Input buffer too small");
+/*
+ * Send the first nbr_of_bufs entries of tx_bufs as pixel data and release
+ * the bus, or leave that to the completion of an asynchronous transfer.
+ */
+static int ssd1351_stream_locked(const struct device *dev, size_t nbr_of_bufs,
+                                 bool last) {
+  const struct ssd1351_config *config = dev->config;
+  int ret;
 
-  ssd1351_set_mem_area(dev, x, y, desc->width, desc->height);
+#ifdef CONFIG_SSD1351_ASYNC_WRITE
+  struct ssd1351_data *data = dev->data;
 
-  if (desc->pitch > desc->width) {
-    write_h = 1U;
-    nbr_of_writes = desc->height;
-  } else {
-    write_h = desc->height;
-    nbr_of_writes = 1U;
+  data->tx_notify = last;
+#ifdef CONFIG_SSD1351_STATS
+  data->tx_write_start = data->write_start;
+#endif
+  ret = ssd1351_transmit_async_locked(dev, config->tx_bufs, nbr_of_bufs);
+  if (ret == 0) {
+    return 0;
   }
+#else
+  ARG_UNUSED(last);
 
-  for (uint16_t write_cnt = 0U; write_cnt < nbr_of_writes; ++write_cnt) {
-    ssd1351_transmit(
-        dev, write_cnt == 0U ? SSD1351_CMD_WRITERAM : SSD1351_CMD_NONE,
-        (void *)write_data_start, desc->width * SSD1351_PIXEL_SIZE * write_h);
-    write_data_start += (desc->pitch * SSD1351_PIXEL_SIZE);
-  }
+  struct spi_buf_set tx = {
+      .buffers = config->tx_bufs,
+      .count = nbr_of_bufs,
+  };
 
-  return 0;
+  ret = ssd1351_transmit_set_locked(dev, SSD1351_CMD_NONE, &tx, true);
+#endif
+
+  ssd1351_bus_release(dev);
+
+  return ret;
+}
+
+/*
+ * Stream a width x height area into the window set up before. Rows of a
+ * strided buffer become separate entries of one spi_buf_set, so the area
+ * costs a single data transaction no matter how it is laid out in memory.
+ */
+static int ssd1351_write_pixels(const struct device *dev, const uint8_t *buf,
+                                uint16_t width, uint16_t height, uint16_t pitch,
+                                bool last) {
+  const struct ssd1351_config *config = dev->config;
+  size_t row_len = width * SSD1351_PIXEL_SIZE;
+  size_t nbr_of_bufs;
+  int ret;
+
+  if ((pitch > width) && (height > config->tx_bufs_count)) {
+    return -EINVAL;
+  }
+
+  ssd1351_bus_acquire(dev);
+
+  ret = ssd1351_transmit_locked(dev, SSD1351_CMD_WRITERAM, NULL, 0);
+  if (ret < 0) {
+    ssd1351_bus_release(dev);
+    return ret;
+  }
+
+  /* The buffer list is only touched once the previous transfer is done */
+  if (pitch > width) {
+    for (uint16_t row = 0U; row < height; ++row) {
+      config->tx_bufs[row].buf = (void *)buf;
+      config->tx_bufs[row].len = row_len;
+      buf += pitch * SSD1351_PIXEL_SIZE;
+    }
+    nbr_of_bufs = height;
+  } else {
+    config->tx_bufs[0].buf = (void *)buf;
+    config->tx_bufs[0].len = row_len * height;
+    nbr_of_bufs = 1U;
+  }
+
+  return ssd1351_stream_locked(dev, nbr_of_bufs, last);
+}
+
+/*
+ * Stream nbr_of_pixels copies of one colour into the window set up before.
+ * Every entry of the scatter list points at the same fill row, so no buffer
+ * of the area's size is ever materialised. The row holds as many pixels as
+ * the panel's longer side, which keeps even a full-screen fill within
+ * tx_bufs_count entries.
+ */
+static int ssd1351_fill_pixels(const struct device *dev, const uint8_t *color,
+                               size_t nbr_of_pixels, bool last) {
+  const struct ssd1351_config *config = dev->config;
+  size_t nbr_of_bufs = 0U;
+  int ret;
+
+  if (DIV_ROUND_UP(nbr_of_pixels, config->tx_bufs_count) >
+      config->tx_bufs_count) {
+    return -EINVAL;
+  }
+
+  ssd1351_bus_acquire(dev);
+
+  ret = ssd1351_transmit_locked(dev, SSD1351_CMD_WRITERAM, NULL, 0);
+  if (ret < 0) {
+    ssd1351_bus_release(dev);
+    return ret;
+  }
+
+  /* The colour may point into the fill row itself */
+  for (uint16_t i = 0U; i < config->tx_bufs_count; ++i) {
+    memmove(&config->fill_row[i * SSD1351_PIXEL_SIZE], color,
+            SSD1351_PIXEL_SIZE);
+  }
+
+  while (nbr_of_pixels > 0U) {
+    size_t len = MIN(nbr_of_pixels, config->tx_bufs_count);
+
+    config->tx_bufs[nbr_of_bufs].buf = config->fill_row;
+    config->tx_bufs[nbr_of_bufs].len = len * SSD1351_PIXEL_SIZE;
+    nbr_of_bufs++;
+    nbr_of_pixels -= len;
+  }
+
+  return ssd1351_stream_locked(dev, nbr_of_bufs, last);
+}
+
+/* Check whether an area holds a single colour, stopping at the first miss */
+static bool ssd1351_area_is_solid(const uint8_t *buf, uint16_t width,
+                                  uint16_t height, uint16_t pitch) {
+  for (uint16_t row = 0U; row < height; ++row) {
+    const uint8_t *p = buf + row * pitch * SSD1351_PIXEL_SIZE;
+
+    for (uint16_t col = 0U; col < width; ++col) {
+      if ((p[0] != buf[0]) || (p[1] != buf[1])) {
+        return false;
+      }
+      p += SSD1351_PIXEL_SIZE;
+    }
+  }
+
+  return true;
+}
+
+/* Report completion of a display_write() that put nothing on the bus */
+static void ssd1351_write_done_now(const struct device *dev) {
+#ifdef CONFIG_SSD1351_ASYNC_WRITE
+  struct ssd1351_data *data = dev->data;
+  ssd1351_write_done_cb_t cb = data->done_cb;
+
+#ifdef CONFIG_SSD1351_STATS
+  ssd1351_stats_write_done(data, data->write_start);
+#endif
+
+  if (cb != NULL) {
+    cb(dev, 0, data->done_user_data);
+  }
+#else
+  ARG_UNUSED(dev);
+#endif
+}
+
+/*
+ * In low power mode only the band is scanned, so cut an area along the row
+ * axis to it. Return how many pixels of the area's buffer to skip; the area
+ * ends up empty if it lies outside of the band.
+ */
+static size_t ssd1351_clip_to_band(const struct device *dev, uint16_t *x,
+                                   uint16_t *y, uint16_t *width,
+                                   uint16_t *height, uint16_t pitch) {
+  struct ssd1351_data *data = dev->data;
+  bool rotated = ssd1351_is_rotated(dev);
+  uint16_t *pos = rotated ? x : y;
+  uint16_t *len = rotated ? width : height;
+  uint16_t band_end = data->band_start + data->band_lines;
+  uint16_t start;
+  uint16_t end;
+
+  if (data->band_lines == 0U) {
+    return 0U;
+  }
+
+  start = CLAMP(*pos, data->band_start, band_end);
+  end = CLAMP(*pos + *len, data->band_start, band_end);
+  if ((start == *pos) && (end == *pos + *len)) {
+    return 0U;
+  }
+
+  size_t skip = (start - *pos) * (rotated ? 1U : pitch);
+
+  data->band_clipped = true;
+  *pos = start;
+  *len = end - start;
+
+  return skip;
+}
+
+/*
+ * Write an area of the caller's buffer. Areas of a single colour, mostly
+ * background, are streamed from the fill row instead, so the transfer no
+ * longer reads the whole buffer.
+ */
+static int ssd1351_write_area(const struct device *dev, uint16_t x,
+                              uint16_t y, uint16_t width, uint16_t height,
+                              uint16_t pitch, const uint8_t *buf, bool last) {
+  uint16_t rows;
+  int ret;
+
+  buf += ssd1351_clip_to_band(dev, &x, &y, &width, &height, pitch) *
+         SSD1351_PIXEL_SIZE;
+  if ((width == 0U) || (height == 0U)) {
+    if (last) {
+      ssd1351_write_done_now(dev);
+    }
+    return 0;
+  }
+
+  rows = ssd1351_rows_before_wrap(dev, x, y, width, height);
+
+  /* Split areas wrapping around the end of GDDRAM in two windows */
+  if (ssd1351_is_rotated(dev) && (rows < width)) {
+    ret = ssd1351_write_area(dev, x, y, rows, height, pitch, buf, false);
+    if (ret < 0) {
+      return ret;
+    }
+    return ssd1351_write_area(dev, x + rows, y, width - rows, height, pitch,
+                              buf + rows * SSD1351_PIXEL_SIZE, last);
+  }
+  if (!ssd1351_is_rotated(dev) && (rows < height)) {
+    ret = ssd1351_write_area(dev, x, y, width, rows, pitch, buf, false);
+    if (ret < 0) {
+      return ret;
+    }
+    return ssd1351_write_area(dev, x, y + rows, width, height - rows, pitch,
+                              buf + rows * pitch * SSD1351_PIXEL_SIZE, last);
+  }
+
+  ret = ssd1351_set_mem_area(dev, x, y, width, height);
+  if (ret < 0) {
+    return ret;
+  }
+
+  if (ssd1351_area_is_solid(buf, width, height, pitch)) {
+    ret = ssd1351_fill_pixels(dev, buf, width * height, last);
+  } else {
+    ret = ssd1351_write_pixels(dev, buf, width, height, pitch, last);
+  }
+  if (ret < 0) {
+    /* The address pointer is wherever the transfer stopped */
+    ssd1351_invalidate_regs(dev, BIT(SSD1351_REG_COLUMN) |
+                                     BIT(SSD1351_REG_ROW));
+  }
+
+  return ret;
+}
+
+static int ssd1351_fill_area(const struct device *dev, uint16_t x,
+                             uint16_t y, uint16_t width, uint16_t height,
+                             const uint8_t *color, bool last) {
+  uint16_t rows;
+  int ret;
+
+  ssd1351_clip_to_band(dev, &x, &y, &width, &height, 0U);
+  if ((width == 0U) || (height == 0U)) {
+    if (last) {
+      ssd1351_write_done_now(dev);
+    }
+    return 0;
+  }
+
+  rows = ssd1351_rows_before_wrap(dev, x, y, width, height);
+
+  if (ssd1351_is_rotated(dev) && (rows < width)) {
+    ret = ssd1351_fill_area(dev, x, y, rows, height, color, false);
+    if (ret < 0) {
+      return ret;
+    }
+    return ssd1351_fill_area(dev, x + rows, y, width - rows, height, color,
+                             last);
+  }
+  if (!ssd1351_is_rotated(dev) && (rows < height)) {
+    ret = ssd1351_fill_area(dev, x, y, width, rows, color, false);
+    if (ret < 0) {
+      return ret;
+    }
+    return ssd1351_fill_area(dev, x, y + rows, width, height - rows, color,
+                             last);
+  }
+
+  ret = ssd1351_set_mem_area(dev, x, y, width, height);
+  if (ret < 0) {
+    return ret;
+  }
+
+  ret = ssd1351_fill_pixels(dev, color, width * height, last);
+  if (ret < 0) {
+    ssd1351_invalidate_regs(dev, BIT(SSD1351_REG_COLUMN) |
+                                     BIT(SSD1351_REG_ROW));
+  }
+
+  return ret;
+}
+
+static uint16_t ssd1351_logical_width(const struct device *dev) {
+  const struct ssd1351_config *config = dev->config;
+  const struct ssd1351_data *data = dev->data;
+
+  if ((data->orientation == DISPLAY_ORIENTATION_ROTATED_90) ||
+      (data->orientation == DISPLAY_ORIENTATION_ROTATED_270)) {
+    return config->height;
+  }
+
+  return config->width;
+}
+
+static uint16_t ssd1351_logical_height(const struct device *dev) {
+  const struct ssd1351_config *config = dev->config;
+  const struct ssd1351_data *data = dev->data;
+
+  if ((data->orientation == DISPLAY_ORIENTATION_ROTATED_90) ||
+      (data->orientation == DISPLAY_ORIENTATION_ROTATED_270)) {
+    return config->width;
+  }
+
+  return config->height;
+}
+
+#ifdef CONFIG_SSD1351_TILE_DIFF
+static void ssd1351_invalidate_tiles(const struct device *dev) {
+  const struct ssd1351_config *config = dev->config;
+  struct ssd1351_data *data = dev->data;
+
+  for (uint16_t i = 0U; i < config->tiles_count; ++i) {
+    config->tiles[i].x0 = UINT8_MAX;
+  }
+  data->tiles_stale = false;
+}
+
+/* FNV-1a over a rectangle of the caller's buffer */
+static uint32_t ssd1351_hash_area(const uint8_t *buf, uint16_t width,
+                                  uint16_t height, uint16_t pitch) {
+  uint32_t hash = 2166136261U;
+
+  for (uint16_t row = 0U; row < height; ++row) {
+    const uint8_t *p = buf + row * pitch * SSD1351_PIXEL_SIZE;
+
+    for (size_t i = 0U; i < width * SSD1351_PIXEL_SIZE; ++i) {
+      hash = (hash ^ p[i]) * 16777619U;
+    }
+  }
+
+  return hash;
+}
+
+/*
+ * Compare the part of a tile covered by this write with what the last write
+ * into the tile sent. Equal coverage and hash mean GDDRAM already holds these
+ * pixels. The tile entry is updated to describe this write either way.
+ */
+static bool ssd1351_tile_changed(struct ssd1351_tile *tile, uint32_t hash,
+                                 uint8_t x0, uint8_t y0, uint8_t x1,
+                                 uint8_t y1) {
+  if ((tile->x0 == x0) && (tile->y0 == y0) && (tile->x1 == x1) &&
+      (tile->y1 == y1) && (tile->hash == hash)) {
+    return false;
+  }
+
+  tile->hash = hash;
+  tile->x0 = x0;
+  tile->y0 = y0;
+  tile->x1 = x1;
+  tile->y1 = y1;
+
+  return true;
+}
+
+/*
+ * Split the area into bands of tile rows and send, per band, only the column
+ * span between the first and last changed tile. Bands with the same span are
+ * merged so a fully changed area still goes out as one window.
+ */
+static int ssd1351_write_diff(const struct device *dev, uint16_t x, uint16_t y,
+                              const struct display_buffer_descriptor *desc,
+                              const uint8_t *buf, bool last) {
+  const struct ssd1351_config *config = dev->config;
+  struct ssd1351_data *data = dev->data;
+  uint16_t tiles_per_row =
+      DIV_ROUND_UP(ssd1351_logical_width(dev), SSD1351_TILE_SIZE);
+  uint16_t x_end = x + desc->width;
+  uint16_t y_end = y + desc->height;
+  size_t pitch_bytes = desc->pitch * SSD1351_PIXEL_SIZE;
+  uint16_t span_x0 = 0U;
+  uint16_t span_x1 = 0U;
+  uint16_t span_y0 = 0U;
+  uint16_t span_y1 = 0U;
+  size_t sent = 0U;
+  int ret = 0;
+
+  if (data->tiles_stale) {
+    ssd1351_invalidate_tiles(dev);
+  }
+
+  for (uint16_t band_y = y - (y % SSD1351_TILE_SIZE); band_y < y_end;
+       band_y += SSD1351_TILE_SIZE) {
+    uint16_t y0 = MAX(band_y, y);
+    uint16_t y1 = MIN(band_y + SSD1351_TILE_SIZE, y_end);
+    uint16_t changed_x0 = UINT16_MAX;
+    uint16_t changed_x1 = 0U;
+
+    for (uint16_t tile_x = x - (x % SSD1351_TILE_SIZE); tile_x < x_end;
+         tile_x += SSD1351_TILE_SIZE) {
+      uint16_t x0 = MAX(tile_x, x);
+      uint16_t x1 = MIN(tile_x + SSD1351_TILE_SIZE, x_end);
+      size_t idx = (band_y / SSD1351_TILE_SIZE) * tiles_per_row +
+                   tile_x / SSD1351_TILE_SIZE;
+      uint32_t hash = ssd1351_hash_area(
+          buf + (y0 - y) * pitch_bytes + (x0 - x) * SSD1351_PIXEL_SIZE,
+          x1 - x0, y1 - y0, desc->pitch);
+
+      __ASSERT(idx < config->tiles_count, "Write outside the tile grid");
+
+      if (ssd1351_tile_changed(&config->tiles[idx], hash, x0 - tile_x,
+                               y0 - band_y, x1 - 1 - tile_x,
+                               y1 - 1 - band_y)) {
+        changed_x0 = MIN(changed_x0, x0);
+        changed_x1 = x1;
+      }
+    }
+
+    if ((span_y1 == y0) && (changed_x0 == span_x0) &&
+        (changed_x1 == span_x1)) {
+      span_y1 = y1;
+      continue;
+    }
+
+    if (span_y1 > span_y0) {
+      ret = ssd1351_write_area(
+          dev, span_x0, span_y0, span_x1 - span_x0, span_y1 - span_y0,
+          desc->pitch,
+          buf + (span_y0 - y) * pitch_bytes +
+              (span_x0 - x) * SSD1351_PIXEL_SIZE,
+          false);
+      if (ret < 0) {
+        break;
+      }
+      sent += (span_x1 - span_x0) * (span_y1 - span_y0);
+    }
+
+    span_x0 = changed_x0;
+    span_x1 = changed_x1;
+    span_y0 = (changed_x0 < changed_x1) ? y0 : 0U;
+    span_y1 = (changed_x0 < changed_x1) ? y1 : 0U;
+  }
+
+  if ((ret == 0) && (span_y1 > span_y0)) {
+    ret = ssd1351_write_area(dev, span_x0, span_y0, span_x1 - span_x0,
+                             span_y1 - span_y0, desc->pitch,
+                             buf + (span_y0 - y) * pitch_bytes +
+                                 (span_x0 - x) * SSD1351_PIXEL_SIZE,
+                             last);
+    sent += (span_x1 - span_x0) * (span_y1 - span_y0);
+  } else if ((ret == 0) && last) {
+    ssd1351_write_done_now(dev);
+  }
+
+  if (ret < 0) {
+    data->tiles_stale = true;
+    return ret;
+  }
+
+  sent *= SSD1351_PIXEL_SIZE;
+  data->diff_stats.bytes_sent += sent;
+  data->diff_stats.bytes_saved +=
+      desc->width * desc->height * SSD1351_PIXEL_SIZE - sent;
+
+  return 0;
+}
+
+/*
+ * Record a fill in the tiles it covers. The fill row stands in for the
+ * pixels, read with a pitch of zero, so the hashes match what a later write
+ * of the same colour produces and that write is skipped.
+ */
+static void ssd1351_tiles_fill(const struct device *dev, uint16_t x, uint16_t y,
+                               uint16_t width, uint16_t height) {
+  const struct ssd1351_config *config = dev->config;
+  struct ssd1351_data *data = dev->data;
+  uint16_t tiles_per_row =
+      DIV_ROUND_UP(ssd1351_logical_width(dev), SSD1351_TILE_SIZE);
+  uint16_t x_end = x + width;
+  uint16_t y_end = y + height;
+
+  if (data->tiles_stale) {
+    ssd1351_invalidate_tiles(dev);
+  }
+
+  for (uint16_t band_y = y - (y % SSD1351_TILE_SIZE); band_y < y_end;
+       band_y += SSD1351_TILE_SIZE) {
+    uint16_t y0 = MAX(band_y, y);
+    uint16_t y1 = MIN(band_y + SSD1351_TILE_SIZE, y_end);
+
+    for (uint16_t tile_x = x - (x % SSD1351_TILE_SIZE); tile_x < x_end;
+         tile_x += SSD1351_TILE_SIZE) {
+      uint16_t x0 = MAX(tile_x, x);
+      uint16_t x1 = MIN(tile_x + SSD1351_TILE_SIZE, x_end);
+      size_t idx = (band_y / SSD1351_TILE_SIZE) * tiles_per_row +
+                   tile_x / SSD1351_TILE_SIZE;
+
+      ssd1351_tile_changed(&config->tiles[idx],
+                           ssd1351_hash_area(config->fill_row, x1 - x0,
+                                             y1 - y0, 0U),
+                           x0 - tile_x, y0 - band_y, x1 - 1 - tile_x,
+                           y1 - 1 - band_y);
+    }
+  }
+}
+#endif /* CONFIG_SSD1351_TILE_DIFF */
+
+int ssd1351_get_diff_stats(const struct device *dev,
+                           struct ssd1351_diff_stats *stats) {
+#ifdef CONFIG_SSD1351_TILE_DIFF
+  const struct ssd1351_data *data = dev->data;
+
+  *stats = data->diff_stats;
+
+  return 0;
+#else
+  ARG_UNUSED(dev);
+  ARG_UNUSED(stats);
+
+  return -ENOTSUP;
+#endif
+}
+
+#ifdef CONFIG_SSD1351_SHADOW_FB
+/*
+ * Index of a logical pixel in the shadow framebuffer. The shadow follows the
+ * controller's address space, so it stays valid across orientation changes
+ * exactly like GDDRAM does: rotated orientations swap the axes and leave the
+ * flips to the remap register. Scrolling rotates the rows; on panels shorter
+ * than GDDRAM the shadow wraps at the panel height instead, which only
+ * matters for rows exposed by a scroll and not written since.
+ */
+static size_t ssd1351_shadow_index(const struct device *dev, uint16_t x,
+                                   uint16_t y) {
+  const struct ssd1351_config *config = dev->config;
+  const struct ssd1351_data *data = dev->data;
+
+  if (ssd1351_is_rotated(dev)) {
+    return (size_t)((x + data->scroll) % config->height) * config->width + y;
+  }
+
+  return (size_t)((y + data->scroll) % config->height) * config->width + x;
+}
+
+static void ssd1351_shadow_update(const struct device *dev, uint16_t x,
+                                  uint16_t y,
+                                  const struct display_buffer_descriptor *desc,
+                                  const uint8_t *buf) {
+  const struct ssd1351_config *config = dev->config;
+
+  for (uint16_t row = 0U; row < desc->height; ++row) {
+    const uint8_t *src = buf + row * desc->pitch * SSD1351_PIXEL_SIZE;
+
+    for (uint16_t col = 0U; col < desc->width; ++col) {
+      memcpy(&config->shadow_fb[ssd1351_shadow_index(dev, x + col, y + row)],
+             src + col * SSD1351_PIXEL_SIZE, SSD1351_PIXEL_SIZE);
+    }
+  }
+}
+
+static void ssd1351_shadow_fill(const struct device *dev, uint16_t x,
+                                uint16_t y, uint16_t width, uint16_t height,
+                                const uint8_t *color) {
+  const struct ssd1351_config *config = dev->config;
+
+  for (uint16_t row = 0U; row < height; ++row) {
+    for (uint16_t col = 0U; col < width; ++col) {
+      memcpy(&config->shadow_fb[ssd1351_shadow_index(dev, x + col, y + row)],
+             color, SSD1351_PIXEL_SIZE);
+    }
+  }
+}
+
+/*
+ * Send the shadow framebuffer to GDDRAM, one logical row at a time through
+ * the fill row. Every row is gathered once the previous transfer is done.
+ */
+static int ssd1351_shadow_restore(const struct device *dev) {
+  const struct ssd1351_config *config = dev->config;
+  uint16_t width = ssd1351_logical_width(dev);
+  uint16_t height = ssd1351_logical_height(dev);
+  int ret = 0;
+
+  for (uint16_t y = 0U; (ret == 0) && (y < height); ++y) {
+    ssd1351_bus_acquire(dev);
+    for (uint16_t x = 0U; x < width; ++x) {
+      memcpy(&config->fill_row[x * SSD1351_PIXEL_SIZE],
+             &config->shadow_fb[ssd1351_shadow_index(dev, x, y)],
+             SSD1351_PIXEL_SIZE);
+    }
+    ssd1351_bus_release(dev);
+
+    ret = ssd1351_write_area(dev, 0, y, width, 1, width, config->fill_row,
+                             false);
+  }
+
+  return ret;
+}
+
+static int ssd1351_read(const struct device *dev, uint16_t x, uint16_t y,
+                        const struct display_buffer_descriptor *desc,
+                        void *buf) {
+  const struct ssd1351_config *config = dev->config;
+  struct ssd1351_data *data = dev->data;
+  uint8_t *dst = buf;
+
+  __ASSERT(desc->width <= desc->pitch, "Pitch is smaller then width");
+  __ASSERT((desc->pitch * SSD1351_PIXEL_SIZE * desc->height) <= desc->buf_size,
+           "Output buffer too small");
+
+  k_mutex_lock(&data->lock, K_FOREVER);
+
+  for (uint16_t row = 0U; row < desc->height; ++row) {
+    for (uint16_t col = 0U; col < desc->width; ++col) {
+      memcpy(dst + col * SSD1351_PIXEL_SIZE,
+             &config->shadow_fb[ssd1351_shadow_index(dev, x + col, y + row)],
+             SSD1351_PIXEL_SIZE);
+    }
+    dst += desc->pitch * SSD1351_PIXEL_SIZE;
+  }
+
+  k_mutex_unlock(&data->lock);
+
+  return 0;
+}
+#endif /* CONFIG_SSD1351_SHADOW_FB */
+
+/*
+ * The bus is down while suspended. With the shadow framebuffer the pixels
+ * are kept there and reach the panel with the restore on resume, otherwise
+ * they are dropped.
+ */
+static int ssd1351_defer_write(const struct device *dev) {
+  struct ssd1351_data *data = dev->data;
+
+#ifdef CONFIG_SSD1351_TILE_DIFF
+  data->tiles_stale = true;
+#endif
+#ifdef CONFIG_SSD1351_SHADOW_FB
+  data->restore_pending = true;
+
+  return 0;
+#else
+  ARG_UNUSED(data);
+
+  return -EBUSY;
+#endif
+}
+
+int ssd1351_fill(const struct device *dev, uint16_t x, uint16_t y,
+                 uint16_t width, uint16_t height, uint16_t color) {
+  struct ssd1351_data *data = dev->data;
+  uint8_t color_be[SSD1351_PIXEL_SIZE];
+  int ret;
+
+  if ((width == 0U) || (height == 0U) ||
+      (x + width > ssd1351_logical_width(dev)) ||
+      (y + height > ssd1351_logical_height(dev))) {
+    return -EINVAL;
+  }
+
+  sys_put_be16(color, color_be);
+
+  k_mutex_lock(&data->lock, K_FOREVER);
+
+  SSD1351_STATS_INC(data, fills);
+
+  if (data->suspended) {
+    ret = ssd1351_defer_write(dev);
+  } else {
+    /* Not a display_write(), so the write done callback is left alone */
+    ret = ssd1351_fill_area(dev, x, y, width, height, color_be, false);
+#ifdef CONFIG_SSD1351_TILE_DIFF
+    if (ret < 0) {
+      data->tiles_stale = true;
+    } else {
+      ssd1351_tiles_fill(dev, x, y, width, height);
+    }
+#endif
+  }
+
+#ifdef CONFIG_SSD1351_SHADOW_FB
+  if (ret == 0) {
+    ssd1351_shadow_fill(dev, x, y, width, height, color_be);
+  }
+#endif
+  if (ret < 0) {
+    SSD1351_STATS_INC(data, errors);
+  }
+
+  k_mutex_unlock(&data->lock);
+
+  return ret;
+}
+
+/*
+ * Without a write done callback nothing tells the caller when its buffer is
+ * free again. lvgl.c's stock flush path, for one, reports every flush done
+ * as soon as display_write() returns, and with a single draw buffer renders
+ * into it right away. Keep the write blocking until the transfer ended then.
+ */
+static int ssd1351_write_finish(const struct device *dev, int ret) {
+#ifdef CONFIG_SSD1351_ASYNC_WRITE
+  const struct ssd1351_data *data = dev->data;
+
+  if ((ret == 0) && (data->done_cb == NULL)) {
+    return ssd1351_wait_idle(dev, K_FOREVER);
+  }
+#else
+  ARG_UNUSED(dev);
+#endif
+
+  return ret;
+}
+
+static int ssd1351_write(const struct device *dev, uint16_t x, uint16_t y,
+                         const struct display_buffer_descriptor *desc,
+                         const void *buf) {
+  struct ssd1351_data *data = dev->data;
+  int ret;
+
+#ifdef CONFIG_SSD1351_RGB332
+  if (data->rgb332) {
+    return ssd1351_write_rgb332(dev, x, y, desc, buf);
+  }
+#endif
+
+  __ASSERT(desc->width <= desc->pitch, "Pitch is smaller then width");
+  __ASSERT((desc->pitch * SSD1351_PIXEL_SIZE * desc->height) <= desc->buf_size,
+           "Input buffer too small");
+
+  k_mutex_lock(&data->lock, K_FOREVER);
+
+  SSD1351_STATS_INC(data, writes);
+#ifdef CONFIG_SSD1351_STATS
+  data->write_start = k_cycle_get_32();
+#endif
+
+  if (data->suspended) {
+    ret = ssd1351_defer_write(dev);
+    if (ret == 0) {
+      ssd1351_write_done_now(dev);
+    }
+  } else {
+#ifdef CONFIG_SSD1351_TILE_DIFF
+    ret = ssd1351_write_diff(dev, x, y, desc, buf, true);
+#else
+    ret = ssd1351_write_area(dev, x, y, desc->width, desc->height,
+                             desc->pitch, buf, true);
+#endif
+    ret = ssd1351_write_finish(dev, ret);
+  }
+
+#ifdef CONFIG_SSD1351_SHADOW_FB
+  if (ret == 0) {
+    ssd1351_shadow_update(dev, x, y, desc, buf);
+  }
+#endif
+
+  if (ret < 0) {
+    SSD1351_STATS_INC(data, errors);
+  }
+#if defined(CONFIG_SSD1351_STATS) && !defined(CONFIG_SSD1351_ASYNC_WRITE)
+  else {
+    ssd1351_stats_write_done(data, data->write_start);
+  }
+#endif
+
+  k_mutex_unlock(&data->lock);
+
+  return ret;
+}
+
+#ifndef CONFIG_SSD1351_TILE_DIFF
+static bool ssd1351_window_wraps(const struct device *dev, uint16_t x,
+                                 uint16_t y, uint16_t width, uint16_t height) {
+  return ssd1351_rows_before_wrap(dev, x, y, width, height) <
+         (ssd1351_is_rotated(dev) ? width : height);
+}
+
+static bool ssd1351_rects_overlap(const struct ssd1351_rect *a,
+                                  const struct ssd1351_rect *b) {
+  return (a->x < b->x + b->desc.width) && (b->x < a->x + a->desc.width) &&
+         (a->y < b->y + b->desc.height) && (b->y < a->y + a->desc.height);
+}
+
+/* Scatter entries ssd1351_add_rect_bufs() needs for an area */
+static size_t ssd1351_rect_bufs(const struct ssd1351_rect *rect) {
+  return (rect->desc.pitch > rect->desc.width) ? rect->desc.height : 1U;
+}
+
+static size_t ssd1351_add_rect_bufs(const struct device *dev,
+                                    const struct ssd1351_rect *rect,
+                                    size_t nbr_of_bufs) {
+  const struct ssd1351_config *config = dev->config;
+  const uint8_t *buf = rect->buf;
+  size_t row_len = rect->desc.width * SSD1351_PIXEL_SIZE;
+
+  if (rect->desc.pitch == rect->desc.width) {
+    config->tx_bufs[nbr_of_bufs].buf = (void *)buf;
+    config->tx_bufs[nbr_of_bufs].len = row_len * rect->desc.height;
+    return nbr_of_bufs + 1U;
+  }
+
+  for (uint16_t row = 0U; row < rect->desc.height; ++row) {
+    config->tx_bufs[nbr_of_bufs].buf = (void *)buf;
+    config->tx_bufs[nbr_of_bufs].len = row_len;
+    buf += rect->desc.pitch * SSD1351_PIXEL_SIZE;
+    nbr_of_bufs++;
+  }
+
+  return nbr_of_bufs;
+}
+
+/*
+ * Sort the areas top to bottom, then left to right, so neighbours end up
+ * next to each other. An area never moves past one it overlaps, which keeps
+ * the later of two overlapping writes on top. Batches are a handful of
+ * areas, so an insertion sort does.
+ */
+static void ssd1351_sort_rects(struct ssd1351_rect *rects, size_t count) {
+  for (size_t i = 1U; i < count; ++i) {
+    struct ssd1351_rect rect = rects[i];
+    size_t j = i;
+
+    while ((j > 0U) && !ssd1351_rects_overlap(&rects[j - 1U], &rect) &&
+           ((rects[j - 1U].y > rect.y) ||
+            ((rects[j - 1U].y == rect.y) && (rects[j - 1U].x > rect.x)))) {
+      rects[j] = rects[j - 1U];
+      j--;
+    }
+    rects[j] = rect;
+  }
+}
+
+/*
+ * Collect the areas after rects[0] that extend its window without a gap,
+ * either side by side with the same rows or stacked with the same columns.
+ * A stacked area further down the list is moved up, provided it overlaps
+ * none of the areas it skips. Return how many areas share the window.
+ */
+static size_t ssd1351_group_rects(const struct device *dev,
+                                  struct ssd1351_rect *rects, size_t count,
+                                  bool *side_by_side) {
+  const struct ssd1351_config *config = dev->config;
+  const struct ssd1351_data *data = dev->data;
+  uint16_t x = rects[0].x;
+  uint16_t y = rects[0].y;
+  uint16_t width = rects[0].desc.width;
+  uint16_t height = rects[0].desc.height;
+  size_t nbr_of_bufs = ssd1351_rect_bufs(&rects[0]);
+  size_t n = 1U;
+
+  /* Areas are cut to the low power band one by one */
+  if (data->band_lines > 0U) {
+    count = 1U;
+  }
+
+  /* Side by side areas interleave, so every row is a scatter entry */
+  while ((n < count) && (rects[n].y == y) &&
+         (rects[n].desc.height == height) && (rects[n].x == x + width) &&
+         ((n + 1U) * height <= config->tx_bufs_count) &&
+         !ssd1351_window_wraps(dev, x, y, width + rects[n].desc.width,
+                               height)) {
+    width += rects[n].desc.width;
+    n++;
+  }
+
+  *side_by_side = (n > 1U);
+  if (*side_by_side) {
+    return n;
+  }
+
+  for (size_t i = 1U; i < count; ++i) {
+    struct ssd1351_rect rect = rects[i];
+    bool blocked = false;
+
+    if ((rect.x != x) || (rect.desc.width != width) ||
+        (rect.y != y + height)) {
+      continue;
+    }
+
+    for (size_t j = n; j < i; ++j) {
+      blocked = blocked || ssd1351_rects_overlap(&rects[j], &rect);
+    }
+
+    if (blocked ||
+        (nbr_of_bufs + ssd1351_rect_bufs(&rect) > config->tx_bufs_count) ||
+        ssd1351_window_wraps(dev, x, y, width, height + rect.desc.height)) {
+      break;
+    }
+
+    memmove(&rects[n + 1U], &rects[n], (i - n) * sizeof(rects[0]));
+    rects[n] = rect;
+    height += rect.desc.height;
+    nbr_of_bufs += ssd1351_rect_bufs(&rect);
+    n++;
+  }
+
+  return n;
+}
+
+/*
+ * Stream a group of areas from ssd1351_group_rects() into the window set up
+ * before. Side by side areas are interleaved row by row.
+ */
+static int ssd1351_write_group_pixels(const struct device *dev,
+                                      const struct ssd1351_rect *rects,
+                                      size_t count, bool side_by_side,
+                                      bool last) {
+  const struct ssd1351_config *config = dev->config;
+  size_t nbr_of_bufs = 0U;
+  int ret;
+
+  ssd1351_bus_acquire(dev);
+
+  ret = ssd1351_transmit_locked(dev, SSD1351_CMD_WRITERAM, NULL, 0);
+  if (ret < 0) {
+    ssd1351_bus_release(dev);
+    return ret;
+  }
+
+  if (side_by_side) {
+    for (uint16_t row = 0U; row < rects[0].desc.height; ++row) {
+      for (size_t i = 0U; i < count; ++i) {
+        const uint8_t *buf = rects[i].buf;
+
+        config->tx_bufs[nbr_of_bufs].buf =
+            (void *)(buf + row * rects[i].desc.pitch * SSD1351_PIXEL_SIZE);
+        config->tx_bufs[nbr_of_bufs].len =
+            rects[i].desc.width * SSD1351_PIXEL_SIZE;
+        nbr_of_bufs++;
+      }
+    }
+  } else {
+    for (size_t i = 0U; i < count; ++i) {
+      nbr_of_bufs = ssd1351_add_rect_bufs(dev, &rects[i], nbr_of_bufs);
+    }
+  }
+
+  return ssd1351_stream_locked(dev, nbr_of_bufs, last);
+}
+
+static int ssd1351_write_group(const struct device *dev,
+                               const struct ssd1351_rect *rects, size_t count,
+                               bool side_by_side, bool last) {
+  uint16_t width = rects[0].desc.width;
+  uint16_t height = rects[0].desc.height;
+  int ret;
+
+  if (count == 1U) {
+    return ssd1351_write_area(dev, rects[0].x, rects[0].y, width, height,
+                              rects[0].desc.pitch, rects[0].buf, last);
+  }
+
+  for (size_t i = 1U; i < count; ++i) {
+    if (side_by_side) {
+      width += rects[i].desc.width;
+    } else {
+      height += rects[i].desc.height;
+    }
+  }
+
+  ret = ssd1351_set_mem_area(dev, rects[0].x, rects[0].y, width, height);
+  if (ret < 0) {
+    return ret;
+  }
+
+  ret = ssd1351_write_group_pixels(dev, rects, count, side_by_side, last);
+  if (ret < 0) {
+    ssd1351_invalidate_regs(dev, BIT(SSD1351_REG_COLUMN) |
+                                     BIT(SSD1351_REG_ROW));
+  }
+
+  return ret;
+}
+#endif /* !CONFIG_SSD1351_TILE_DIFF */
+
+/*
+ * With the tile diff stage every area is reduced to its changed tiles
+ * first, which already merges what it can, so the areas go out one by one.
+ */
+static int ssd1351_write_batch(const struct device *dev,
+                               struct ssd1351_rect *rects, size_t count) {
+  size_t n;
+  int ret;
+
+  for (size_t first = 0U; first < count; first += n) {
+#ifdef CONFIG_SSD1351_TILE_DIFF
+    n = 1U;
+    ret = ssd1351_write_diff(dev, rects[first].x, rects[first].y,
+                             &rects[first].desc, rects[first].buf,
+                             first + 1U == count);
+#else
+    bool side_by_side;
+
+    if (first == 0U) {
+      ssd1351_sort_rects(rects, count);
+    }
+
+    n = ssd1351_group_rects(dev, &rects[first], count - first,
+                            &side_by_side);
+    ret = ssd1351_write_group(dev, &rects[first], n, side_by_side,
+                              first + n == count);
+#endif
+    if (ret < 0) {
+      return ret;
+    }
+  }
+
+  return 0;
+}
+
+int ssd1351_write_rects(const struct device *dev, struct ssd1351_rect *rects,
+                        size_t count) {
+  struct ssd1351_data *data = dev->data;
+  int ret;
+
+  if (count == 0U) {
+    return -EINVAL;
+  }
+
+  for (size_t i = 0U; i < count; ++i) {
+    const struct display_buffer_descriptor *desc = &rects[i].desc;
+
+    __ASSERT(desc->width <= desc->pitch, "Pitch is smaller then width");
+    __ASSERT((desc->pitch * SSD1351_PIXEL_SIZE * desc->height) <=
+                 desc->buf_size,
+             "Input buffer too small");
+
+    if ((desc->width == 0U) || (desc->height == 0U) ||
+        (rects[i].x + desc->width > ssd1351_logical_width(dev)) ||
+        (rects[i].y + desc->height > ssd1351_logical_height(dev))) {
+      return -EINVAL;
+    }
+  }
+
+  k_mutex_lock(&data->lock, K_FOREVER);
+
+  SSD1351_STATS_INC(data, writes);
+#ifdef CONFIG_SSD1351_STATS
+  data->write_start = k_cycle_get_32();
+#endif
+
+  if (data->suspended) {
+    ret = ssd1351_defer_write(dev);
+    if (ret == 0) {
+      ssd1351_write_done_now(dev);
+    }
+  } else {
+    ret = ssd1351_write_batch(dev, rects, count);
+    ret = ssd1351_write_finish(dev, ret);
+  }
+
+#ifdef CONFIG_SSD1351_SHADOW_FB
+  for (size_t i = 0U; (ret == 0) && (i < count); ++i) {
+    ssd1351_shadow_update(dev, rects[i].x, rects[i].y, &rects[i].desc,
+                          rects[i].buf);
+  }
+#endif
+
+  if (ret < 0) {
+    SSD1351_STATS_INC(data, errors);
+  }
+#if defined(CONFIG_SSD1351_STATS) && !defined(CONFIG_SSD1351_ASYNC_WRITE)
+  else {
+    ssd1351_stats_write_done(data, data->write_start);
+  }
+#endif
+
+  k_mutex_unlock(&data->lock);
+
+  return ret;
+}
+
+#ifdef CONFIG_SSD1351_RGB332
+#define SSD1351_EXPAND_CHUNK CONFIG_SSD1351_RGB332_CHUNK_SIZE
+/* One chunk is expanded while the previous one is still on the bus */
+#define SSD1351_EXPAND_BUFS (IS_ENABLED(CONFIG_SSD1351_ASYNC_WRITE) ? 2 : 1)
+
+/* Scale each RGB332 channel to the full RGB565 range */
+#define SSD1351_RGB332_TO_RGB565(i)                                            \
+  (((((i) >> 5) & 0x7) * 31 / 7) << 11 | ((((i) >> 2) & 0x7) * 63 / 7) << 5 | \
+   (((i) & 0x3) * 31 / 3))
+#define SSD1351_RGB332_LUT_ENTRY(i, _)                                         \
+  {SSD1351_RGB332_TO_RGB565(i) >> 8, SSD1351_RGB332_TO_RGB565(i) & 0xFF}
+
+/* RGB565 in wire order for every RGB332 value */
+static const uint8_t ssd1351_rgb332_lut[256][SSD1351_PIXEL_SIZE] = {
+    LISTIFY(256, SSD1351_RGB332_LUT_ENTRY, (, ))};
+
+/*
+ * Stream a width x height RGB332 area into the window set up before. The
+ * pixels are expanded chunk by chunk, each chunk going out as one data
+ * transaction after the single WRITERAM.
+ */
+static int ssd1351_write_rgb332_pixels(const struct device *dev,
+                                       const uint8_t *buf, uint16_t width,
+                                       uint16_t height, uint16_t pitch,
+                                       bool last) {
+  const struct ssd1351_config *config = dev->config;
+  uint16_t row = 0U;
+  uint16_t col = 0U;
+  int ret;
+
+  ret = ssd1351_transmit(dev, SSD1351_CMD_WRITERAM, NULL, 0);
+
+  for (uint8_t chunk = 0U; (ret == 0) && (row < height);
+       chunk = (chunk + 1U) % SSD1351_EXPAND_BUFS) {
+    uint8_t *dst =
+        &config->expand_buf[chunk * SSD1351_EXPAND_CHUNK * SSD1351_PIXEL_SIZE];
+    size_t len = 0U;
+
+    /* The chunk was last used two transfers ago, which is done by now */
+    while ((len < SSD1351_EXPAND_CHUNK) && (row < height)) {
+      memcpy(&dst[len * SSD1351_PIXEL_SIZE],
+             ssd1351_rgb332_lut[buf[row * pitch + col]], SSD1351_PIXEL_SIZE);
+      len++;
+      if (++col == width) {
+        col = 0U;
+        row++;
+      }
+    }
+
+    ssd1351_bus_acquire(dev);
+    config->tx_bufs[0].buf = dst;
+    config->tx_bufs[0].len = len * SSD1351_PIXEL_SIZE;
+    ret = ssd1351_stream_locked(dev, 1U, last && (row == height));
+  }
+
+  return ret;
+}
+
+static int ssd1351_write_rgb332_area(const struct device *dev, uint16_t x,
+                                     uint16_t y, uint16_t width,
+                                     uint16_t height, uint16_t pitch,
+                                     const uint8_t *buf, bool last) {
+  uint16_t rows;
+  int ret;
+
+  buf += ssd1351_clip_to_band(dev, &x, &y, &width, &height, pitch);
+  if ((width == 0U) || (height == 0U)) {
+    if (last) {
+      ssd1351_write_done_now(dev);
+    }
+    return 0;
+  }
+
+  rows = ssd1351_rows_before_wrap(dev, x, y, width, height);
+
+  if (ssd1351_is_rotated(dev) && (rows < width)) {
+    ret = ssd1351_write_rgb332_area(dev, x, y, rows, height, pitch, buf,
+                                    false);
+    if (ret < 0) {
+      return ret;
+    }
+    return ssd1351_write_rgb332_area(dev, x + rows, y, width - rows, height,
+                                     pitch, buf + rows, last);
+  }
+  if (!ssd1351_is_rotated(dev) && (rows < height)) {
+    ret = ssd1351_write_rgb332_area(dev, x, y, width, rows, pitch, buf,
+                                    false);
+    if (ret < 0) {
+      return ret;
+    }
+    return ssd1351_write_rgb332_area(dev, x, y + rows, width, height - rows,
+                                     pitch, buf + rows * pitch, last);
+  }
+
+  ret = ssd1351_set_mem_area(dev, x, y, width, height);
+  if (ret < 0) {
+    return ret;
+  }
+
+  ret = ssd1351_write_rgb332_pixels(dev, buf, width, height, pitch, last);
+  if (ret < 0) {
+    ssd1351_invalidate_regs(dev, BIT(SSD1351_REG_COLUMN) |
+                                     BIT(SSD1351_REG_ROW));
+  }
+
+  return ret;
+}
+
+#ifdef CONFIG_SSD1351_SHADOW_FB
+static void
+ssd1351_shadow_update_rgb332(const struct device *dev, uint16_t x, uint16_t y,
+                             const struct display_buffer_descriptor *desc,
+                             const uint8_t *buf) {
+  const struct ssd1351_config *config = dev->config;
+
+  for (uint16_t row = 0U; row < desc->height; ++row) {
+    const uint8_t *src = buf + row * desc->pitch;
+
+    for (uint16_t col = 0U; col < desc->width; ++col) {
+      memcpy(&config->shadow_fb[ssd1351_shadow_index(dev, x + col, y + row)],
+             ssd1351_rgb332_lut[src[col]], SSD1351_PIXEL_SIZE);
+    }
+  }
+}
+#endif
+#endif /* CONFIG_SSD1351_RGB332 */
+
+int ssd1351_write_rgb332(const struct device *dev, uint16_t x, uint16_t y,
+                         const struct display_buffer_descriptor *desc,
+                         const void *buf) {
+#ifdef CONFIG_SSD1351_RGB332
+  struct ssd1351_data *data = dev->data;
+  int ret;
+
+  __ASSERT(desc->width <= desc->pitch, "Pitch is smaller then width");
+  __ASSERT((desc->pitch * desc->height) <= desc->buf_size,
+           "Input buffer too small");
+
+  if ((desc->width == 0U) || (desc->height == 0U) ||
+      (x + desc->width > ssd1351_logical_width(dev)) ||
+      (y + desc->height > ssd1351_logical_height(dev))) {
+    return -EINVAL;
+  }
+
+  k_mutex_lock(&data->lock, K_FOREVER);
+
+  SSD1351_STATS_INC(data, writes);
+#ifdef CONFIG_SSD1351_STATS
+  data->write_start = k_cycle_get_32();
+#endif
+
+  if (data->suspended) {
+    ret = ssd1351_defer_write(dev);
+    if (ret == 0) {
+      ssd1351_write_done_now(dev);
+    }
+  } else {
+    ret = ssd1351_write_rgb332_area(dev, x, y, desc->width, desc->height,
+                                    desc->pitch, buf, true);
+  }
+
+#ifdef CONFIG_SSD1351_SHADOW_FB
+  if (ret == 0) {
+    ssd1351_shadow_update_rgb332(dev, x, y, desc, buf);
+  }
+#endif
+
+  if (ret < 0) {
+    SSD1351_STATS_INC(data, errors);
+  }
+#if defined(CONFIG_SSD1351_STATS) && !defined(CONFIG_SSD1351_ASYNC_WRITE)
+  else {
+    ssd1351_stats_write_done(data, data->write_start);
+  }
+#endif
+
+  k_mutex_unlock(&data->lock);
+
+  return ret;
+#else
+  ARG_UNUSED(dev);
+  ARG_UNUSED(x);
+  ARG_UNUSED(y);
+  ARG_UNUSED(desc);
+  ARG_UNUSED(buf);
+
+  return -ENOTSUP;
+#endif
 }
 
 static void
@@ -193,20 +2027,97 @@ ssd1351_get_capabilities(const struct device *dev,
   }
   capabilities->supported_pixel_formats = PIXEL_FORMAT_RGB_565;
   capabilities->current_pixel_format = PIXEL_FORMAT_RGB_565;
+#ifdef CONFIG_SSD1351_RGB332
+  capabilities->supported_pixel_formats |= SSD1351_PIXEL_FORMAT_RGB_332;
+  if (data->rgb332) {
+    capabilities->current_pixel_format = SSD1351_PIXEL_FORMAT_RGB_332;
+  }
+#endif
   capabilities->current_orientation = data->orientation;
 }
 
+/*
+ * The controller always takes RGB565. RGB332 is expanded by the driver, so
+ * the format only decides how display_write() reads its buffer.
+ */
 static int ssd1351_set_pixel_format(const struct device *dev,
                                     enum display_pixel_format pixel_format) {
-  if (pixel_format == PIXEL_FORMAT_RGB_565) {
-    return 0;
+#ifdef CONFIG_SSD1351_RGB332
+  struct ssd1351_data *data = dev->data;
+
+  if ((pixel_format != PIXEL_FORMAT_RGB_565) &&
+      (pixel_format != SSD1351_PIXEL_FORMAT_RGB_332)) {
+    return -ENOTSUP;
   }
 
-  return -ENOTSUP;
+  k_mutex_lock(&data->lock, K_FOREVER);
+  data->rgb332 = pixel_format == SSD1351_PIXEL_FORMAT_RGB_332;
+  k_mutex_unlock(&data->lock);
+
+  return 0;
+#else
+  ARG_UNUSED(dev);
+
+  return (pixel_format == PIXEL_FORMAT_RGB_565) ? 0 : -ENOTSUP;
+#endif
 }
 
-static int ssd1351_set_orientation(const struct device *dev,
-                                   enum display_orientation orientation) {
+/*
+ * Program how the controller scans GDDRAM: the start line follows the
+ * scroll and the display offset, which maps COM lines to panel rows without
+ * touching GDDRAM, the pixel shift. Whether a positive offset moves the
+ * picture towards the start of the logical axis depends on the COM scan
+ * direction. In low power mode only the band's lines are multiplexed, at a
+ * slower clock, and start line and offset move so that the band stays where
+ * it is on the panel.
+ */
+static int ssd1351_apply_scan(const struct device *dev) {
+  const struct ssd1351_config *config = dev->config;
+  const struct ssd1351_data *data = dev->data;
+  bool com_reverse = (data->orientation == DISPLAY_ORIENTATION_NORMAL) ||
+                     (data->orientation == DISPLAY_ORIENTATION_ROTATED_90);
+  bool band = data->band_lines > 0U;
+  uint8_t first = band ? data->band_start : 0U;
+  uint8_t lines = band ? data->band_lines : config->height;
+  int16_t offset = com_reverse ? data->pixel_shift : -data->pixel_shift;
+  uint8_t clockdiv =
+      band ? CONFIG_SSD1351_LOW_POWER_CLOCKDIV : SSD1351_CLOCKDIV_DEFAULT;
+  uint8_t mux = lines - 1U;
+  uint8_t startline =
+      (data->y_offset + data->scroll + first) % SSD1351_GDDRAM_ROWS;
+  int ret;
+
+  /* A reversed scan ends at the band, a forward one starts there */
+  offset += com_reverse ? config->height - lines - first : first;
+  offset = (offset % SSD1351_GDDRAM_ROWS + SSD1351_GDDRAM_ROWS) %
+           SSD1351_GDDRAM_ROWS;
+
+  uint8_t display_offset = offset;
+
+  ret = ssd1351_set_reg(dev, SSD1351_REG_CLOCKDIV, SSD1351_CMD_CLOCKDIV,
+                        &clockdiv, 1);
+  if (ret < 0) {
+    return ret;
+  }
+
+  ret = ssd1351_set_reg(dev, SSD1351_REG_MUXRATIO, SSD1351_CMD_MUXRATIO, &mux,
+                        1);
+  if (ret < 0) {
+    return ret;
+  }
+
+  ret = ssd1351_set_reg(dev, SSD1351_REG_STARTLINE, SSD1351_CMD_STARTLINE,
+                        &startline, 1);
+  if (ret < 0) {
+    return ret;
+  }
+
+  return ssd1351_set_reg(dev, SSD1351_REG_DISPLAYOFFSET,
+                         SSD1351_CMD_DISPLAYOFFSET, &display_offset, 1);
+}
+
+static int ssd1351_apply_orientation(const struct device *dev,
+                                     enum display_orientation orientation) {
   const struct ssd1351_config *config = dev->config;
   struct ssd1351_data *data = dev->data;
   uint8_t remap = BIT(6) | BIT(5) | BIT(2);
@@ -250,128 +2161,535 @@ static int ssd1351_set_orientation(const struct device *dev,
     return -ENOTSUP;
   }
 
-  int ret = ssd1351_transmit(dev, SSD1351_CMD_SETREMAP, &remap, 1);
+  int ret = ssd1351_set_reg(dev, SSD1351_REG_REMAP, SSD1351_CMD_SETREMAP,
+                            &remap, 1);
   if (ret < 0) {
     return ret;
   }
 
-  uint8_t startline = data->y_offset;
-  ret = ssd1351_transmit(dev, SSD1351_CMD_STARTLINE, &startline, 1);
+  if (data->orientation != orientation) {
+#ifdef CONFIG_SSD1351_TILE_DIFF
+    /* The tile grid is laid out in the old logical coordinates */
+    data->tiles_stale = true;
+#endif
+    data->orientation = orientation;
+  }
+
+  return ssd1351_apply_scan(dev);
+}
+
+static int ssd1351_set_orientation(const struct device *dev,
+                                   enum display_orientation orientation) {
+  struct ssd1351_data *data = dev->data;
+  int ret;
+
+  if (orientation > DISPLAY_ORIENTATION_ROTATED_270) {
+    return -ENOTSUP;
+  }
+
+  k_mutex_lock(&data->lock, K_FOREVER);
+
+  if (data->suspended) {
+    /* Applied by the resume, later writes already use it */
+    if (data->orientation != orientation) {
+#ifdef CONFIG_SSD1351_TILE_DIFF
+      data->tiles_stale = true;
+#endif
+      data->orientation = orientation;
+    }
+    ret = 0;
+  } else {
+    ret = ssd1351_apply_orientation(dev, orientation);
+  }
+
+  k_mutex_unlock(&data->lock);
+
+  return ret;
+}
+
+/*
+ * Dim by scaling the colour contrast currents, which keeps 256 steps where
+ * CONTRASTMASTER only has 16. The master current stays at its maximum.
+ */
+static int ssd1351_apply_brightness(const struct device *dev) {
+  struct ssd1351_data *data = dev->data;
+  uint8_t contrast[3] = {
+      SSD1351_CONTRAST_A * data->brightness / UINT8_MAX,
+      SSD1351_CONTRAST_B * data->brightness / UINT8_MAX,
+      SSD1351_CONTRAST_C * data->brightness / UINT8_MAX,
+  };
+
+  return ssd1351_set_reg(dev, SSD1351_REG_CONTRAST, SSD1351_CMD_CONTRASTABC,
+                         contrast, sizeof(contrast));
+}
+
+static int ssd1351_set_brightness(const struct device *dev,
+                                  const uint8_t brightness) {
+  struct ssd1351_data *data = dev->data;
+  int ret;
+
+  k_mutex_lock(&data->lock, K_FOREVER);
+  data->brightness = brightness;
+  /* Resume applies it otherwise */
+  ret = data->suspended ? 0 : ssd1351_apply_brightness(dev);
+  k_mutex_unlock(&data->lock);
+
+  return ret;
+}
+
+int ssd1351_set_pixel_shift(const struct device *dev, int8_t lines) {
+  struct ssd1351_data *data = dev->data;
+  int ret;
+
+  k_mutex_lock(&data->lock, K_FOREVER);
+  data->pixel_shift = lines;
+  /* Resume applies it otherwise */
+  ret = data->suspended ? 0 : ssd1351_apply_scan(dev);
+  k_mutex_unlock(&data->lock);
+
+  return ret;
+}
+
+int ssd1351_set_low_power(const struct device *dev, uint16_t start,
+                          uint16_t lines) {
+  const struct ssd1351_config *config = dev->config;
+  struct ssd1351_data *data = dev->data;
+  int ret;
+
+  if ((lines != 0U) &&
+      ((lines < SSD1351_MUX_MIN_LINES) || (start + lines > config->height))) {
+    return -EINVAL;
+  }
+
+  k_mutex_lock(&data->lock, K_FOREVER);
+
+  data->band_start = start;
+  data->band_lines = lines;
+
+  if (data->suspended) {
+    /* Resume applies it otherwise */
+    ret = 0;
+  } else {
+    ret = ssd1351_apply_scan(dev);
+  }
+
+  /* Writes cut to the band left the rest of GDDRAM behind */
+  if ((ret == 0) && (lines == 0U) && data->band_clipped) {
+    data->band_clipped = false;
+#ifdef CONFIG_SSD1351_TILE_DIFF
+    data->tiles_stale = true;
+#endif
+#ifdef CONFIG_SSD1351_SHADOW_FB
+    if (data->suspended) {
+      data->restore_pending = true;
+    } else {
+      ret = ssd1351_shadow_restore(dev);
+    }
+#endif
+  }
+
+  k_mutex_unlock(&data->lock);
+
+  return ret;
+}
+
+int ssd1351_scroll(const struct device *dev, int16_t lines) {
+  struct ssd1351_data *data = dev->data;
+  uint8_t old_scroll;
+  int ret;
+
+  k_mutex_lock(&data->lock, K_FOREVER);
+
+  if (data->suspended) {
+    k_mutex_unlock(&data->lock);
+    return -EBUSY;
+  }
+
+  old_scroll = data->scroll;
+  data->scroll =
+      (data->scroll + lines % SSD1351_GDDRAM_ROWS + SSD1351_GDDRAM_ROWS) %
+      SSD1351_GDDRAM_ROWS;
+
+  ret = ssd1351_apply_scan(dev);
   if (ret < 0) {
-    return ret;
+    data->scroll = old_scroll;
+  } else if (data->scroll != old_scroll) {
+#ifdef CONFIG_SSD1351_TILE_DIFF
+    /* The tiles describe logical positions, whose content just moved */
+    data->tiles_stale = true;
+#endif
   }
 
-  data->orientation = orientation;
+  k_mutex_unlock(&data->lock);
 
-  return 0;
+  return ret;
 }
 
-static int ssd1351_lcd_init(const struct device *dev) {
+/* Enough for the longest run of same-level bytes in an init table */
+#define SSD1351_INIT_MAX_BUFS 4
+
+static int ssd1351_init_cmds_flush(const struct device *dev, bool cmd,
+                                   struct spi_buf_set *tx) {
   const struct ssd1351_config *config = dev->config;
   int ret;
-  uint8_t param;
 
-  param = 0x12;
-  ret = ssd1351_transmit(dev, SSD1351_CMD_COMMANDLOCK, &param, 1);
-  if (ret < 0) {
-    return ret;
+  if (tx->count == 0U) {
+    return 0;
   }
 
-  param = 0xB1;
-  ret = ssd1351_transmit(dev, SSD1351_CMD_COMMANDLOCK, &param, 1);
-  if (ret < 0) {
-    return ret;
+  if (config->cmd_data_gpio.port != NULL) {
+    gpio_pin_set_dt(&config->cmd_data_gpio, cmd ? 1 : 0);
+  }
+  ret = spi_write_dt(&config->bus, tx);
+#ifdef CONFIG_SSD1351_STATS
+  if (ret == 0) {
+    struct ssd1351_data *data = dev->data;
+
+    STATS_INC(data->stats, transactions);
+    if (cmd) {
+      STATS_INCN(data->stats, commands, ssd1351_buf_set_len(tx));
+    } else {
+      STATS_INCN(data->stats, param_bytes, ssd1351_buf_set_len(tx));
+    }
   }
+#endif
+  tx->count = 0U;
 
-  ret = ssd1351_transmit(dev, SSD1351_CMD_DISPLAYOFF, NULL, 0);
-  if (ret < 0) {
-    return ret;
+  return ret;
+}
+
+/*
+ * Run an init table. Consecutive bytes on the same D/C level are gathered
+ * into one transaction, so a sequence costs one transaction per D/C change
+ * rather than two per command.
+ */
+static int ssd1351_run_init_cmds(const struct device *dev, const uint8_t *cmds,
+                                 size_t len) {
+  struct spi_buf bufs[SSD1351_INIT_MAX_BUFS];
+  struct spi_buf_set tx = {
+      .buffers = bufs,
+      .count = 0U,
+  };
+  bool cmd = true;
+  size_t i = 0U;
+  int ret = 0;
+
+  ssd1351_bus_acquire(dev);
+
+  while ((ret == 0) && (i + 1U < len)) {
+    uint8_t nbr_of_params = cmds[i + 1U] & SSD1351_INIT_LEN_MASK;
+    bool delay = (cmds[i + 1U] & SSD1351_INIT_DELAY) != 0U;
+
+    __ASSERT(i + 2U + nbr_of_params + (delay ? 1U : 0U) <= len,
+             "Truncated init table");
+
+    if (!cmd || (tx.count == ARRAY_SIZE(bufs))) {
+      ret = ssd1351_init_cmds_flush(dev, cmd, &tx);
+      cmd = true;
+    }
+    bufs[tx.count].buf = (void *)&cmds[i];
+    bufs[tx.count].len = 1U;
+    tx.count++;
+    i += 2U;
+
+    if ((ret == 0) && (nbr_of_params > 0U)) {
+      ret = ssd1351_init_cmds_flush(dev, cmd, &tx);
+      cmd = false;
+      bufs[tx.count].buf = (void *)&cmds[i];
+      bufs[tx.count].len = nbr_of_params;
+      tx.count++;
+      i += nbr_of_params;
+    }
+
+    if ((ret == 0) && delay) {
+      ret = ssd1351_init_cmds_flush(dev, cmd, &tx);
+      k_msleep(cmds[i]);
+      i++;
+    }
   }
 
-  param = 0xF1;
-  ret = ssd1351_transmit(dev, SSD1351_CMD_CLOCKDIV, &param, 1);
-  if (ret < 0) {
-    return ret;
+  if (ret == 0) {
+    ret = ssd1351_init_cmds_flush(dev, cmd, &tx);
   }
 
-  param = config->height - 1;
-  ret = ssd1351_transmit(dev, SSD1351_CMD_MUXRATIO, &param, 1);
-  if (ret < 0) {
-    return ret;
+  ssd1351_bus_release(dev);
+
+  return ret;
+}
+
+#ifdef CONFIG_SSD1351_BOOT_SPLASH
+#define SSD1351_RLE_RUN_SIZE (1U + SSD1351_PIXEL_SIZE)
+
+/* Pixels covered by the runs of an encoded image */
+static size_t ssd1351_rle_pixels(const struct ssd1351_splash *splash) {
+  size_t pixels = 0U;
+
+  for (size_t i = 0U; i + SSD1351_RLE_RUN_SIZE <= splash->len;
+       i += SSD1351_RLE_RUN_SIZE) {
+    pixels += splash->data[i] + 1U;
   }
 
-  param = 0x00;
-  ret = ssd1351_transmit(dev, SSD1351_CMD_DISPLAYOFFSET, &param, 1);
+  return pixels;
+}
+
+/*
+ * Stream an encoded image into its window one run at a time. WRITERAM does
+ * not move the address pointer, so each run carries on where the previous
+ * one stopped and the runs add up to a write filling the whole window.
+ */
+static int ssd1351_write_rle(const struct device *dev, uint16_t x, uint16_t y,
+                             const struct ssd1351_splash *splash) {
+  int ret;
+
+  ret = ssd1351_set_mem_area(dev, x, y, splash->width, splash->height);
+
+  for (size_t i = 0U; (ret == 0) && (i < splash->len);
+       i += SSD1351_RLE_RUN_SIZE) {
+    ret = ssd1351_fill_pixels(dev, &splash->data[i + 1U],
+                              splash->data[i] + 1U, false);
+  }
   if (ret < 0) {
-    return ret;
+    ssd1351_invalidate_regs(dev, BIT(SSD1351_REG_COLUMN) |
+                                     BIT(SSD1351_REG_ROW));
   }
 
-  param = 0x00;
-  ret = ssd1351_transmit(dev, SSD1351_CMD_SETGPIO, &param, 1);
-  if (ret < 0) {
-    return ret;
+#ifdef CONFIG_SSD1351_SHADOW_FB
+  const struct ssd1351_config *config = dev->config;
+  size_t pixel = 0U;
+
+  for (size_t i = 0U; (ret == 0) && (i < splash->len);
+       i += SSD1351_RLE_RUN_SIZE) {
+    for (uint16_t n = 0U; n <= splash->data[i]; ++n, ++pixel) {
+      memcpy(&config->shadow_fb[ssd1351_shadow_index(
+                 dev, x + pixel % splash->width, y + pixel / splash->width)],
+             &splash->data[i + 1U], SSD1351_PIXEL_SIZE);
+    }
   }
+#endif
 
-  param = 0x01;
-  ret = ssd1351_transmit(dev, SSD1351_CMD_FUNCTIONSELECT, &param, 1);
-  if (ret < 0) {
-    return ret;
+  return ret;
+}
+
+/*
+ * Put the boot splash on the freshly reset panel. It also covers the noise
+ * GDDRAM holds after power-up, so the screen is cleared around it.
+ */
+static int ssd1351_draw_splash(const struct device *dev) {
+  const struct ssd1351_splash *splash = &ssd1351_boot_splash;
+  struct ssd1351_data *data = dev->data;
+  uint16_t width = ssd1351_logical_width(dev);
+  uint16_t height = ssd1351_logical_height(dev);
+  size_t pixels = splash->width * splash->height;
+  int ret;
+
+  /* A broken image is not worth failing the display over */
+  if ((splash->width > width) || (splash->height > height) ||
+      (pixels != (splash->rle ? ssd1351_rle_pixels(splash)
+                              : splash->len / SSD1351_PIXEL_SIZE))) {
+    LOG_ERR("Invalid boot splash, leaving it out");
+    pixels = 0U;
   }
 
-  param = 0x32;
-  ret = ssd1351_transmit(dev, SSD1351_CMD_PRECHARGE, &param, 1);
-  if (ret < 0) {
+  ret = ssd1351_fill(dev, 0, 0, width, height, splash->background);
+  if ((ret < 0) || (pixels == 0U)) {
     return ret;
   }
 
-  param = 0x05;
-  ret = ssd1351_transmit(dev, SSD1351_CMD_VCOMH, &param, 1);
-  if (ret < 0) {
-    return ret;
+  uint16_t x = (width - splash->width) / 2U;
+  uint16_t y = (height - splash->height) / 2U;
+
+  /* Not a display_write(), so nobody is told about its completion */
+  k_mutex_lock(&data->lock, K_FOREVER);
+  if (splash->rle) {
+    ret = ssd1351_write_rle(dev, x, y, splash);
+  } else {
+    ret = ssd1351_write_area(dev, x, y, splash->width, splash->height,
+                             splash->width, splash->data, false);
+#ifdef CONFIG_SSD1351_SHADOW_FB
+    if (ret == 0) {
+      struct display_buffer_descriptor desc = {
+          .buf_size = splash->len,
+          .width = splash->width,
+          .height = splash->height,
+          .pitch = splash->width,
+      };
+
+      ssd1351_shadow_update(dev, x, y, &desc, splash->data);
+    }
+#endif
   }
+#ifdef CONFIG_SSD1351_TILE_DIFF
+  data->tiles_stale = true;
+#endif
+  k_mutex_unlock(&data->lock);
+
+  return ret;
+}
+#endif /* CONFIG_SSD1351_BOOT_SPLASH */
+
+static int ssd1351_lcd_init(const struct device *dev) {
+  const struct ssd1351_config *config = dev->config;
+  const struct ssd1351_data *data = dev->data;
+  int ret;
 
-  uint8_t contrast[] = {0xC8, 0x80, 0xC8};
-  ret = ssd1351_transmit(dev, SSD1351_CMD_CONTRASTABC, contrast,
-                         sizeof(contrast));
+  /* Reset brought every register back to its power-on value */
+  ssd1351_invalidate_regs(dev, BIT_MASK(SSD1351_REG_COUNT));
+#ifdef CONFIG_SSD1351_TILE_DIFF
+  ssd1351_invalidate_tiles(dev);
+#endif
+
+  ret = ssd1351_run_init_cmds(dev, config->init_cmds, config->init_cmds_len);
   if (ret < 0) {
     return ret;
   }
 
-  param = 0x0F;
-  ret = ssd1351_transmit(dev, SSD1351_CMD_CONTRASTMASTER, &param, 1);
+  /* The table leaves CONTRASTABC to the brightness, and the scan registers
+   * to ssd1351_apply_scan() through the orientation
+   */
+  ret = ssd1351_apply_brightness(dev);
   if (ret < 0) {
     return ret;
   }
 
-  uint8_t vsl[] = {0xA0, 0xB5, 0x55};
-  ret = ssd1351_transmit(dev, SSD1351_CMD_SETVSL, vsl, sizeof(vsl));
+  /* Starts out as the devicetree rotation, later the last one applied */
+  return ssd1351_apply_orientation(dev, data->orientation);
+}
+
+/*
+ * Bring the freshly reset controller up and light the panel, unless it is
+ * blanked. Pixels written before, with a deferred bring-up, are waiting in
+ * the shadow framebuffer.
+ */
+static int ssd1351_panel_init(const struct device *dev) {
+  int ret;
+
+  ret = ssd1351_lcd_init(dev);
   if (ret < 0) {
     return ret;
   }
 
-  param = 0x01;
-  ret = ssd1351_transmit(dev, SSD1351_CMD_PRECHARGE2, &param, 1);
+#ifdef CONFIG_SSD1351_SHADOW_FB
+  struct ssd1351_data *data = dev->data;
+
+  /* Also covers the noise GDDRAM holds after power-up */
+  if (data->restore_pending) {
+    data->restore_pending = false;
+    ret = ssd1351_shadow_restore(dev);
+    if (ret < 0) {
+      return ret;
+    }
+
+    return ssd1351_apply_blanking(dev);
+  }
+#endif
+
+#ifdef CONFIG_SSD1351_BOOT_SPLASH
+  ret = ssd1351_draw_splash(dev);
+#else
+  /* GDDRAM holds noise after power-up, clear it before the panel lights up */
+  ret = ssd1351_fill(dev, 0, 0, ssd1351_logical_width(dev),
+                     ssd1351_logical_height(dev), 0x0000);
+#endif
   if (ret < 0) {
     return ret;
   }
 
-  ret = ssd1351_transmit(dev, SSD1351_CMD_NORMALDISPLAY, NULL, 0);
+  return ssd1351_apply_blanking(dev);
+}
+
+#ifdef CONFIG_SSD1351_DEFERRED_INIT
+/*
+ * The reset pulse of ssd1351_reset() as a state machine, so the delays
+ * leave the init thread alone, followed by the panel init proper. The
+ * mutex is recursive, so the API calls made by the last step go through
+ * while everybody else waits for it.
+ */
+static void ssd1351_init_work_handler(struct k_work *work) {
+  struct k_work_delayable *dwork = k_work_delayable_from_work(work);
+  struct ssd1351_data *data =
+      CONTAINER_OF(dwork, struct ssd1351_data, init_work);
+  const struct device *dev = data->dev;
+  const struct ssd1351_config *config = dev->config;
+  bool has_reset = config->reset_gpio.port != NULL;
+  uint32_t start;
+  int ret;
+
+  switch (data->init_step) {
+  case SSD1351_INIT_RESET:
+    if (has_reset) {
+      gpio_pin_set_dt(&config->reset_gpio, 1);
+    }
+    data->init_step = SSD1351_INIT_RELEASE;
+    k_work_schedule(dwork, has_reset ? K_MSEC(10) : K_NO_WAIT);
+    return;
+  case SSD1351_INIT_RELEASE:
+    if (has_reset) {
+      gpio_pin_set_dt(&config->reset_gpio, 0);
+    }
+    data->init_step = SSD1351_INIT_PANEL;
+    k_work_schedule(dwork, has_reset ? K_MSEC(10) : K_NO_WAIT);
+    return;
+  case SSD1351_INIT_PANEL:
+    break;
+  }
+
+  start = k_cycle_get_32();
+
+  k_mutex_lock(&data->lock, K_FOREVER);
+  data->suspended = false;
+  ret = ssd1351_panel_init(dev);
+  data->init_result = ret;
+  k_mutex_unlock(&data->lock);
+
+  k_sem_give(&data->panel_up);
+
   if (ret < 0) {
-    return ret;
+    LOG_ERR("Panel bring-up failed (%d)", ret);
+    return;
   }
 
-  return ssd1351_set_orientation(dev, config->default_orientation);
+  LOG_INF("Panel up in %u us", k_cyc_to_us_floor32(k_cycle_get_32() - start));
 }
+#endif
 
 static int ssd1351_init(const struct device *dev) {
   const struct ssd1351_config *config = dev->config;
   int ret;
 
+  struct ssd1351_data *data = dev->data;
+
   if (!spi_is_ready_dt(&config->bus)) {
     LOG_ERR("SPI device not ready");
     return -ENODEV;
   }
 
+  k_mutex_init(&data->lock);
+
+#ifdef CONFIG_SSD1351_STATS
+  ret = stats_init_and_reg(
+      STATS_HDR(data->stats), STATS_SIZE_INIT_PARMS(data->stats, STATS_SIZE_32),
+      STATS_NAME_INIT_PARMS(ssd1351), dev->name);
+  if (ret < 0) {
+    LOG_WRN("Couldn't register stats (%d)", ret);
+  }
+#endif
+
+  data->cmd_spi_config = config->bus.config;
+  data->cmd_spi_config.frequency = config->command_frequency;
+  data->pixel_spi_config = config->bus.config;
+  data->pixel_spi_config.frequency = config->pixel_frequency;
+#ifdef CONFIG_SSD1351_FRAME_HOLD_CS
+  data->frame_spi_config = config->bus.config;
+  /* Pixels are most of a frame, its few commands ride along at their clock */
+  data->frame_spi_config.frequency = config->pixel_frequency;
+  data->frame_spi_config.operation |= SPI_HOLD_ON_CS | SPI_LOCK_ON;
+#endif
+
+#ifdef CONFIG_SSD1351_ASYNC_WRITE
+  data->dev = dev;
+  k_sem_init(&data->tx_idle, 1, 1);
+#endif
+
   if (config->reset_gpio.port != NULL) {
     if (!gpio_is_ready_dt(&config->reset_gpio)) {
       LOG_ERR("Reset GPIO device not ready");
@@ -398,26 +2716,201 @@ static int ssd1351_init(const struct device *dev) {
     }
   }
 
+#ifdef CONFIG_SSD1351_DEFERRED_INIT
+  data->dev = dev;
+  data->init_step = SSD1351_INIT_RESET;
+  k_sem_init(&data->panel_up, 0, K_SEM_MAX_LIMIT);
+  k_work_init_delayable(&data->init_work, ssd1351_init_work_handler);
+  /* Writes and settings are held as while suspended until the panel is up */
+  data->suspended = true;
+
+  /* Same settling time as ssd1351_reset() */
+  k_work_schedule(&data->init_work, K_MSEC(1));
+
+  return 0;
+#else
+  uint32_t start = k_cycle_get_32();
+
   ssd1351_reset(dev);
 
+  ret = ssd1351_panel_init(dev);
+  if (ret < 0) {
+    return ret;
+  }
+
+  LOG_INF("Panel up in %u us",
+          k_cyc_to_us_floor32(k_cycle_get_32() - start));
+
+  return 0;
+#endif
+}
+
+#ifdef CONFIG_SSD1351_PM_SUSPEND_BUS
+static int ssd1351_bus_pm_action(const struct device *dev,
+                                 enum pm_device_action action) {
+  const struct ssd1351_config *config = dev->config;
+  int ret = pm_device_action_run(config->bus.bus, action);
+
+  /* Buses without PM support or already in the requested state are fine */
+  if ((ret == -ENOSYS) || (ret == -EALREADY)) {
+    return 0;
+  }
+
+  return ret;
+}
+#endif
+
+/*
+ * Put the controller to sleep, optionally with its internal VDD regulator
+ * off, then take the D/C pin and the SPI bus down. The reset line is left
+ * driven, releasing it would reset the controller.
+ */
+static int ssd1351_suspend(const struct device *dev) {
+  const struct ssd1351_config *config = dev->config;
+  struct ssd1351_data *data = dev->data;
+  int ret;
+
+  ssd1351_bus_acquire(dev);
+  ret = ssd1351_transmit_locked(dev, SSD1351_CMD_DISPLAYOFF, NULL, 0);
+#ifdef CONFIG_SSD1351_PM_VDD_OFF
+  if (ret == 0) {
+    uint8_t vdd_off = 0x00;
+
+    ret = ssd1351_transmit_locked(dev, SSD1351_CMD_FUNCTIONSELECT, &vdd_off,
+                                  1);
+  }
+#endif
+#ifdef CONFIG_SSD1351_FRAME_HOLD_CS
+  /*
+   * A frame may be open, its remaining writes are deferred like any other.
+   * The bus is suspended next, so it must not stay locked to the frame.
+   */
+  if (ret == 0) {
+    ret = ssd1351_frame_unlock_bus(dev);
+  }
+#endif
+  ssd1351_bus_release(dev);
+  if (ret < 0) {
+    return ret;
+  }
+
+  if (config->cmd_data_gpio.port != NULL) {
+    ret = gpio_pin_configure_dt(&config->cmd_data_gpio, GPIO_DISCONNECTED);
+    if (ret < 0) {
+      return ret;
+    }
+  }
+
+#ifdef CONFIG_SSD1351_PM_SUSPEND_BUS
+  ret = ssd1351_bus_pm_action(dev, PM_DEVICE_ACTION_SUSPEND);
+  if (ret < 0) {
+    return ret;
+  }
+#endif
+
+  data->suspended = true;
+
+  return 0;
+}
+
+/*
+ * Bring the bus back and wake the controller. GDDRAM and the registers are
+ * retained through sleep, so only pixels written while suspended need to
+ * be sent. Without the internal VDD regulator nothing is retained and the
+ * panel is initialised again and restored from the shadow framebuffer.
+ */
+static int ssd1351_resume(const struct device *dev) {
+  const struct ssd1351_config *config = dev->config;
+  struct ssd1351_data *data = dev->data;
+  uint32_t start = k_cycle_get_32();
+  int ret;
+
+#ifdef CONFIG_SSD1351_PM_SUSPEND_BUS
+  ret = ssd1351_bus_pm_action(dev, PM_DEVICE_ACTION_RESUME);
+  if (ret < 0) {
+    return ret;
+  }
+#endif
+
+  if (config->cmd_data_gpio.port != NULL) {
+    ret = gpio_pin_configure_dt(&config->cmd_data_gpio, GPIO_OUTPUT);
+    if (ret < 0) {
+      return ret;
+    }
+  }
+
+  data->suspended = false;
+
+#ifdef CONFIG_SSD1351_PM_VDD_OFF
+  ssd1351_reset(dev);
   ret = ssd1351_lcd_init(dev);
   if (ret < 0) {
     return ret;
   }
+  data->restore_pending = true;
+#else
+  ret = ssd1351_apply_brightness(dev);
+  if (ret < 0) {
+    return ret;
+  }
+
+  /* Picks up an orientation set while suspended */
+  ret = ssd1351_apply_orientation(dev, data->orientation);
+  if (ret < 0) {
+    return ret;
+  }
+#endif
+
+#ifdef CONFIG_SSD1351_SHADOW_FB
+  if (data->restore_pending) {
+    ret = ssd1351_shadow_restore(dev);
+    if (ret < 0) {
+      return ret;
+    }
+    data->restore_pending = false;
+#ifdef CONFIG_SSD1351_TILE_DIFF
+    data->tiles_stale = true;
+#endif
+  }
+#endif
+
+  ret = ssd1351_apply_blanking(dev);
+  if (ret < 0) {
+    return ret;
+  }
+
+  LOG_INF("Resumed in %u us", k_cyc_to_us_floor32(k_cycle_get_32() - start));
 
-  return ssd1351_blanking_off(dev);
+  return 0;
 }
 
 static int ssd1351_pm_action(const struct device *dev,
                              enum pm_device_action action) {
+  struct ssd1351_data *data = dev->data;
+  int ret;
+
+  ret = ssd1351_await_panel(dev, K_FOREVER);
+  if (ret < 0) {
+    return ret;
+  }
+
+  k_mutex_lock(&data->lock, K_FOREVER);
+
   switch (action) {
   case PM_DEVICE_ACTION_RESUME:
-    return ssd1351_blanking_off(dev);
+    ret = ssd1351_resume(dev);
+    break;
   case PM_DEVICE_ACTION_SUSPEND:
-    return ssd1351_blanking_on(dev);
+    ret = ssd1351_suspend(dev);
+    break;
   default:
-    return -ENOTSUP;
+    ret = -ENOTSUP;
+    break;
   }
+
+  k_mutex_unlock(&data->lock);
+
+  return ret;
 }
 
 #ifdef CONFIG_PM_DEVICE
@@ -433,29 +2926,104 @@ static const struct display_driver_api ssd1351_api = {
     .blanking_on = ssd1351_blanking_on,
     .blanking_off = ssd1351_blanking_off,
     .write = ssd1351_write,
+#ifdef CONFIG_SSD1351_SHADOW_FB
+    .read = ssd1351_read,
+#endif
     .get_capabilities = ssd1351_get_capabilities,
     .set_pixel_format = ssd1351_set_pixel_format,
+    .set_brightness = ssd1351_set_brightness,
     .set_orientation = ssd1351_set_orientation,
 };
 
+#ifdef CONFIG_SSD1351_TILE_DIFF
+#define SSD1351_TILES_DEFINE(inst)                                             \
+  static struct ssd1351_tile ssd1351_tiles_##inst                              \
+      [DIV_ROUND_UP(DT_INST_PROP(inst, width), SSD1351_TILE_SIZE) *            \
+       DIV_ROUND_UP(DT_INST_PROP(inst, height), SSD1351_TILE_SIZE)]
+#define SSD1351_TILES_INIT(inst)                                               \
+  .tiles = ssd1351_tiles_##inst, .tiles_count = ARRAY_SIZE(ssd1351_tiles_##inst),
+#else
+#define SSD1351_TILES_DEFINE(inst)
+#define SSD1351_TILES_INIT(inst)
+#endif
+
+#ifdef CONFIG_SSD1351_SHADOW_FB
+#ifdef CONFIG_SSD1351_SHADOW_FB_CUSTOM_SECTION
+#define SSD1351_SHADOW_FB_ATTR                                                 \
+  __attribute__((section(CONFIG_SSD1351_SHADOW_FB_SECTION)))
+#else
+#define SSD1351_SHADOW_FB_ATTR
+#endif
+#define SSD1351_SHADOW_FB_DEFINE(inst)                                         \
+  static uint16_t ssd1351_shadow_fb_##inst[DT_INST_PROP(inst, width) *         \
+                                           DT_INST_PROP(inst, height)]         \
+      SSD1351_SHADOW_FB_ATTR
+#define SSD1351_SHADOW_FB_INIT(inst) .shadow_fb = ssd1351_shadow_fb_##inst,
+#else
+#define SSD1351_SHADOW_FB_DEFINE(inst)
+#define SSD1351_SHADOW_FB_INIT(inst)
+#endif
+
+#ifdef CONFIG_SSD1351_RGB332
+#define SSD1351_EXPAND_BUF_DEFINE(inst)                                        \
+  static uint8_t ssd1351_expand_buf_##inst[SSD1351_EXPAND_BUFS *               \
+                                           SSD1351_EXPAND_CHUNK *              \
+                                           SSD1351_PIXEL_SIZE]
+#define SSD1351_EXPAND_BUF_INIT(inst) .expand_buf = ssd1351_expand_buf_##inst,
+#else
+#define SSD1351_EXPAND_BUF_DEFINE(inst)
+#define SSD1351_EXPAND_BUF_INIT(inst)
+#endif
+
 #define SSD1351_INIT(inst)                                                     \
+  static const uint8_t ssd1351_init_cmds_##inst[] = {                          \
+      SSD1351_CMD_COMMANDLOCK, 1, 0x12,                                        \
+      SSD1351_CMD_COMMANDLOCK, 1, 0xB1,                                        \
+      SSD1351_CMD_DISPLAYOFF, 0,                                               \
+      SSD1351_CMD_SETGPIO, 1, 0x00,                                            \
+      SSD1351_CMD_FUNCTIONSELECT, 1, 0x01,                                     \
+      SSD1351_CMD_PRECHARGE, 1, 0x32,                                          \
+      SSD1351_CMD_VCOMH, 1, 0x05,                                              \
+      SSD1351_CMD_CONTRASTMASTER, 1, 0x0F,                                     \
+      SSD1351_CMD_SETVSL, 3, 0xA0, 0xB5, 0x55,                                 \
+      SSD1351_CMD_PRECHARGE2, 1, 0x01,                                         \
+      SSD1351_CMD_NORMALDISPLAY, 0,                                            \
+  };                                                                           \
+  static struct spi_buf ssd1351_tx_bufs_##inst[MAX(                            \
+      DT_INST_PROP(inst, width), DT_INST_PROP(inst, height))];                 \
+  static uint8_t ssd1351_fill_row_##inst[ARRAY_SIZE(ssd1351_tx_bufs_##inst) *  \
+                                         SSD1351_PIXEL_SIZE];                  \
+  SSD1351_TILES_DEFINE(inst);                                                  \
+  SSD1351_SHADOW_FB_DEFINE(inst);                                              \
+  SSD1351_EXPAND_BUF_DEFINE(inst);                                             \
   static const struct ssd1351_config ssd1351_config_##inst = {                 \
       .bus =                                                                   \
           SPI_DT_SPEC_INST_GET(inst, SPI_OP_MODE_MASTER | SPI_WORD_SET(8), 0), \
+      .command_frequency = DT_INST_PROP_OR(                                    \
+          inst, command_frequency, DT_INST_PROP(inst, spi_max_frequency)),     \
+      .pixel_frequency = DT_INST_PROP_OR(inst, pixel_frequency,                \
+                                         DT_INST_PROP(inst, spi_max_frequency)), \
       .cmd_data_gpio = GPIO_DT_SPEC_INST_GET_OR(inst, cmd_data_gpios, {}),     \
       .reset_gpio = GPIO_DT_SPEC_INST_GET_OR(inst, reset_gpios, {}),           \
       .width = DT_INST_PROP(inst, width),                                      \
       .height = DT_INST_PROP(inst, height),                                    \
       .x_offset = DT_INST_PROP(inst, x_offset),                                \
       .y_offset = DT_INST_PROP(inst, y_offset),                                \
-      .default_orientation =                                                   \
-          SSD1351_ROTATION_TO_ORIENTATION(DT_INST_PROP_OR(inst, rotation, 0)), \
+      .init_cmds = ssd1351_init_cmds_##inst,                                   \
+      .init_cmds_len = sizeof(ssd1351_init_cmds_##inst),                       \
+      .tx_bufs = ssd1351_tx_bufs_##inst,                                       \
+      .tx_bufs_count = ARRAY_SIZE(ssd1351_tx_bufs_##inst),                     \
+      .fill_row = ssd1351_fill_row_##inst,                                     \
+      SSD1351_TILES_INIT(inst)                                                 \
+      SSD1351_SHADOW_FB_INIT(inst)                                             \
+      SSD1351_EXPAND_BUF_INIT(inst)                                            \
   };                                                                           \
   static struct ssd1351_data ssd1351_data_##inst = {                           \
       .x_offset = DT_INST_PROP(inst, x_offset),                                \
       .y_offset = DT_INST_PROP(inst, y_offset),                                \
       .orientation =                                                           \
           SSD1351_ROTATION_TO_ORIENTATION(DT_INST_PROP_OR(inst, rotation, 0)), \
+      .brightness = UINT8_MAX,                                                 \
   };                                                                           \
   SSD1351_PM_ACTION_DEFINE(inst);                                              \
   DEVICE_DT_INST_DEFINE(inst, &ssd1351_init, SSD1351_PM_ACTION_GET(inst),      \
@@ -13,8 +13,11 @@
 #define SSD1351_CMD_SETREMAP             0xA0
 #define SSD1351_CMD_STARTLINE            0xA1
 #define SSD1351_CMD_DISPLAYOFFSET        0xA2
+#define SSD1351_CMD_DISPLAYALLOFF        0xA4
+#define SSD1351_CMD_DISPLAYALLON         0xA5
 #define SSD1351_CMD_FUNCTIONSELECT       0xAB
 #define SSD1351_CMD_NORMALDISPLAY        0xA6
+#define SSD1351_CMD_INVERTDISPLAY        0xA7
 #define SSD1351_CMD_DISPLAYOFF           0xAE
 #define SSD1351_CMD_DISPLAYON            0xAF
 #define SSD1351_CMD_PRECHARGE            0xB1
@@ -29,4 +32,26 @@
 #define SSD1351_CMD_COMMANDLOCK          0xFD
 #define SSD1351_CMD_NONE                 0xFF
 
+/* Colour contrast currents at full brightness, scaled down for dimming */
+#define SSD1351_CONTRAST_A               0xC8
+#define SSD1351_CONTRAST_B               0x80
+#define SSD1351_CONTRAST_C               0xC8
+
+/* Oscillator and divider outside of low power mode */
+#define SSD1351_CLOCKDIV_DEFAULT         0xF1
+
+/* Fewest COM lines MUXRATIO can multiplex */
+#define SSD1351_MUX_MIN_LINES            16
+
+/* GDDRAM rows, the start line and the address pointer wrap at this */
+#define SSD1351_GDDRAM_ROWS              128
+
+/*
+ * Init sequences are byte tables of entries laid out as
+ *   opcode, length, parameters[length & SSD1351_INIT_LEN_MASK], [delay_ms]
+ * where SSD1351_INIT_DELAY in the length byte appends a delay in ms.
+ */
+#define SSD1351_INIT_LEN_MASK            0x7F
+#define SSD1351_INIT_DELAY               0x80
+
 #endif
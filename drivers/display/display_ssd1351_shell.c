@@ -0,0 +1,152 @@
+/*
+ * Copyright (c) 2024
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#define DT_DRV_COMPAT zmk_ssd1351
+
+#include <zephyr/device.h>
+#include <drivers/display/ssd1351.h>
+#include <zephyr/drivers/display.h>
+#include <zephyr/shell/shell.h>
+#include <zephyr/stats/stats.h>
+#include <zephyr/sys/util.h>
+
+static const struct device *const ssd1351_dev = DEVICE_DT_INST_GET(0);
+
+static int ssd1351_shell_check_ready(const struct shell *sh) {
+  if (!device_is_ready(ssd1351_dev)) {
+    shell_error(sh, "Display device not ready");
+    return -ENODEV;
+  }
+
+  return 0;
+}
+
+#ifdef CONFIG_SSD1351_SHADOW_FB
+/*
+ * Print the panel as one line of big-endian RGB565 hex per row, preceded by a
+ * header with the resolution, so a host script can turn it into an image.
+ */
+static int cmd_screenshot(const struct shell *sh, size_t argc, char **argv) {
+  struct display_capabilities caps;
+  static uint8_t row[MAX(DT_INST_PROP(0, width), DT_INST_PROP(0, height)) * 2];
+  static char line[sizeof(row) * 2 + 1];
+  int ret = ssd1351_shell_check_ready(sh);
+
+  ARG_UNUSED(argc);
+  ARG_UNUSED(argv);
+
+  if (ret < 0) {
+    return ret;
+  }
+
+  display_get_capabilities(ssd1351_dev, &caps);
+
+  struct display_buffer_descriptor desc = {
+      .buf_size = sizeof(row),
+      .width = caps.x_resolution,
+      .height = 1,
+      .pitch = caps.x_resolution,
+  };
+
+  shell_print(sh, "ssd1351 %u %u rgb565be", caps.x_resolution,
+              caps.y_resolution);
+
+  for (uint16_t y = 0U; y < caps.y_resolution; ++y) {
+    ret = display_read(ssd1351_dev, 0, y, &desc, row);
+    if (ret < 0) {
+      shell_error(sh, "Read failed (%d)", ret);
+      return ret;
+    }
+
+    bin2hex(row, caps.x_resolution * 2U, line, sizeof(line));
+    shell_print(sh, "%s", line);
+  }
+
+  return 0;
+}
+#endif /* CONFIG_SSD1351_SHADOW_FB */
+
+#ifdef CONFIG_SSD1351_STATS
+static struct stats_hdr *ssd1351_shell_stats(const struct shell *sh) {
+  struct stats_hdr *hdr = stats_group_find(ssd1351_dev->name);
+
+  if (hdr == NULL) {
+    shell_error(sh, "No statistics registered for %s", ssd1351_dev->name);
+  }
+
+  return hdr;
+}
+
+static int ssd1351_shell_print_stat(struct stats_hdr *hdr, void *arg,
+                                    const char *name, uint16_t off) {
+  const struct shell *sh = arg;
+
+  shell_print(sh, "%-16s %u", name, *(uint32_t *)((uint8_t *)hdr + off));
+
+  return 0;
+}
+
+static int cmd_stats(const struct shell *sh, size_t argc, char **argv) {
+  struct stats_hdr *hdr = ssd1351_shell_stats(sh);
+
+  ARG_UNUSED(argc);
+  ARG_UNUSED(argv);
+
+  if (hdr == NULL) {
+    return -ENOENT;
+  }
+
+  stats_walk(hdr, ssd1351_shell_print_stat, (void *)sh);
+  shell_print(sh, "%-16s %u", "elided_bytes",
+              ssd1351_get_elided_bytes(ssd1351_dev));
+
+#ifdef CONFIG_SSD1351_TILE_DIFF
+  struct ssd1351_diff_stats diff;
+
+  if (ssd1351_get_diff_stats(ssd1351_dev, &diff) == 0) {
+    shell_print(sh, "%-16s %u", "diff_bytes_sent", diff.bytes_sent);
+    shell_print(sh, "%-16s %u", "diff_bytes_saved", diff.bytes_saved);
+  }
+#endif
+
+  return 0;
+}
+
+static int cmd_stats_clear(const struct shell *sh, size_t argc, char **argv) {
+  struct stats_hdr *hdr = ssd1351_shell_stats(sh);
+
+  ARG_UNUSED(argc);
+  ARG_UNUSED(argv);
+
+  if (hdr == NULL) {
+    return -ENOENT;
+  }
+
+  stats_reset(hdr);
+
+  return 0;
+}
+
+SHELL_STATIC_SUBCMD_SET_CREATE(sub_ssd1351_stats,
+                               SHELL_CMD(clear, NULL, "Zero the counters",
+                                         cmd_stats_clear),
+                               SHELL_SUBCMD_SET_END);
+#endif /* CONFIG_SSD1351_STATS */
+
+SHELL_STATIC_SUBCMD_SET_CREATE(
+    sub_ssd1351,
+#ifdef CONFIG_SSD1351_SHADOW_FB
+    SHELL_CMD(screenshot, NULL, "Dump the panel contents as RGB565 hex rows",
+              cmd_screenshot),
+#endif
+#ifdef CONFIG_SSD1351_STATS
+    SHELL_CMD(stats, &sub_ssd1351_stats,
+              "Print bus counters and the write duration histogram",
+              cmd_stats),
+#endif
+    SHELL_SUBCMD_SET_END);
+
+SHELL_CMD_REGISTER(ssd1351, &sub_ssd1351, "SSD1351 display driver", NULL);
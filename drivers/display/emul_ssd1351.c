@@ -0,0 +1,348 @@
+/*
+ * Copyright (c) 2024
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#define DT_DRV_COMPAT zmk_ssd1351
+
+#include "display_ssd1351.h"
+
+#include <string.h>
+
+#include <drivers/display/emul_ssd1351.h>
+#include <zephyr/device.h>
+#include <zephyr/drivers/emul.h>
+#include <zephyr/drivers/gpio.h>
+#include <zephyr/drivers/gpio/gpio_emul.h>
+#include <zephyr/drivers/spi.h>
+#include <zephyr/drivers/spi_emul.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/sys/util.h>
+
+LOG_MODULE_REGISTER(emul_ssd1351, CONFIG_DISPLAY_LOG_LEVEL);
+
+#define SSD1351_EMUL_MAX_PARAMS 3
+
+#define SSD1351_REMAP_VERTICAL BIT(0)
+#define SSD1351_REMAP_COLUMN BIT(1)
+#define SSD1351_REMAP_COM_REVERSE BIT(4)
+
+/* Parameters unlocking and locking the command interface */
+#define SSD1351_UNLOCK 0x12
+#define SSD1351_LOCK 0x16
+
+struct ssd1351_emul_cfg {
+  struct gpio_dt_spec cmd_data_gpio;
+};
+
+struct ssd1351_emul_data {
+  uint16_t gddram[EMUL_SSD1351_GDDRAM_ROWS][EMUL_SSD1351_GDDRAM_COLS];
+  struct emul_ssd1351_stats stats;
+  emul_ssd1351_trace_cb_t trace_cb;
+  void *trace_user_data;
+
+  uint8_t cmd;
+  uint8_t params[SSD1351_EMUL_MAX_PARAMS];
+  uint8_t nbr_of_params;
+  bool locked;
+  bool writing;
+
+  uint8_t col_start;
+  uint8_t col_end;
+  uint8_t row_start;
+  uint8_t row_end;
+  uint8_t col;
+  uint8_t row;
+  uint8_t pixel_msb;
+  bool have_msb;
+
+  uint8_t remap;
+  uint8_t startline;
+  uint8_t display_offset;
+  uint8_t mux_ratio;
+  uint8_t display_mode;
+  bool display_on;
+};
+
+static void ssd1351_emul_power_on_reset(struct ssd1351_emul_data *data) {
+  data->cmd = SSD1351_CMD_NONE;
+  data->nbr_of_params = 0U;
+  data->locked = false;
+  data->writing = false;
+  data->col_start = 0U;
+  data->col_end = EMUL_SSD1351_GDDRAM_COLS - 1U;
+  data->row_start = 0U;
+  data->row_end = EMUL_SSD1351_GDDRAM_ROWS - 1U;
+  data->col = 0U;
+  data->row = 0U;
+  data->have_msb = false;
+  data->remap = 0x40;
+  data->startline = 0U;
+  data->display_offset = 0x60;
+  data->mux_ratio = EMUL_SSD1351_GDDRAM_ROWS - 1U;
+  data->display_mode = SSD1351_CMD_NORMALDISPLAY;
+  data->display_on = false;
+}
+
+static void ssd1351_emul_advance(struct ssd1351_emul_data *data) {
+  if ((data->remap & SSD1351_REMAP_VERTICAL) != 0U) {
+    if (data->row++ >= data->row_end) {
+      data->row = data->row_start;
+      if (data->col++ >= data->col_end) {
+        data->col = data->col_start;
+      }
+    }
+  } else {
+    if (data->col++ >= data->col_end) {
+      data->col = data->col_start;
+      if (data->row++ >= data->row_end) {
+        data->row = data->row_start;
+      }
+    }
+  }
+}
+
+static void ssd1351_emul_command(struct ssd1351_emul_data *data,
+                                 uint8_t cmd) {
+  data->stats.cmd_bytes++;
+
+  if (data->locked && (cmd != SSD1351_CMD_COMMANDLOCK)) {
+    LOG_WRN("Command 0x%02x ignored, interface locked", cmd);
+    data->cmd = SSD1351_CMD_NONE;
+    return;
+  }
+
+  data->cmd = cmd;
+  data->nbr_of_params = 0U;
+  data->writing = false;
+
+  switch (cmd) {
+  case SSD1351_CMD_WRITERAM:
+    data->writing = true;
+    data->have_msb = false;
+    data->stats.writes++;
+    break;
+  case SSD1351_CMD_SETCOLUMN:
+  case SSD1351_CMD_SETROW:
+    data->stats.window_cmds++;
+    break;
+  case SSD1351_CMD_DISPLAYOFF:
+    data->display_on = false;
+    break;
+  case SSD1351_CMD_DISPLAYON:
+    data->display_on = true;
+    break;
+  case SSD1351_CMD_DISPLAYALLOFF:
+  case SSD1351_CMD_DISPLAYALLON:
+  case SSD1351_CMD_NORMALDISPLAY:
+  case SSD1351_CMD_INVERTDISPLAY:
+    data->display_mode = cmd;
+    break;
+  default:
+    break;
+  }
+}
+
+static void ssd1351_emul_param(struct ssd1351_emul_data *data, uint8_t param) {
+  if (data->nbr_of_params < SSD1351_EMUL_MAX_PARAMS) {
+    data->params[data->nbr_of_params++] = param;
+  }
+
+  switch (data->cmd) {
+  case SSD1351_CMD_SETCOLUMN:
+    if (data->nbr_of_params == 2U) {
+      data->col_start = MIN(data->params[0], EMUL_SSD1351_GDDRAM_COLS - 1);
+      data->col_end = MIN(data->params[1], EMUL_SSD1351_GDDRAM_COLS - 1);
+      data->col = data->col_start;
+    }
+    break;
+  case SSD1351_CMD_SETROW:
+    if (data->nbr_of_params == 2U) {
+      data->row_start = MIN(data->params[0], EMUL_SSD1351_GDDRAM_ROWS - 1);
+      data->row_end = MIN(data->params[1], EMUL_SSD1351_GDDRAM_ROWS - 1);
+      data->row = data->row_start;
+    }
+    break;
+  case SSD1351_CMD_SETREMAP:
+    data->remap = param;
+    break;
+  case SSD1351_CMD_STARTLINE:
+    data->startline = param & 0x7F;
+    break;
+  case SSD1351_CMD_DISPLAYOFFSET:
+    data->display_offset = param & 0x7F;
+    break;
+  case SSD1351_CMD_MUXRATIO:
+    data->mux_ratio = CLAMP(param & 0x7F, 15, EMUL_SSD1351_GDDRAM_ROWS - 1);
+    break;
+  case SSD1351_CMD_COMMANDLOCK:
+    if (param == SSD1351_LOCK) {
+      data->locked = true;
+    } else if (param == SSD1351_UNLOCK) {
+      data->locked = false;
+    }
+    break;
+  default:
+    break;
+  }
+}
+
+static void ssd1351_emul_data_byte(struct ssd1351_emul_data *data,
+                                   uint8_t byte) {
+  data->stats.data_bytes++;
+
+  if (!data->writing) {
+    ssd1351_emul_param(data, byte);
+    return;
+  }
+
+  if (!data->have_msb) {
+    data->pixel_msb = byte;
+    data->have_msb = true;
+    return;
+  }
+
+  data->gddram[data->row][data->col] = (data->pixel_msb << 8) | byte;
+  data->have_msb = false;
+  data->stats.pixels++;
+  ssd1351_emul_advance(data);
+}
+
+static int ssd1351_emul_io(const struct emul *target,
+                           const struct spi_config *config,
+                           const struct spi_buf_set *tx_bufs,
+                           const struct spi_buf_set *rx_bufs) {
+  const struct ssd1351_emul_cfg *cfg = target->cfg;
+  struct ssd1351_emul_data *data = target->data;
+  /* D/C is a plain pin on the controller: low selects command */
+  bool cmd = gpio_emul_output_get(cfg->cmd_data_gpio.port,
+                                  cfg->cmd_data_gpio.pin) == 0;
+
+  ARG_UNUSED(config);
+  ARG_UNUSED(rx_bufs);
+
+  if (tx_bufs == NULL) {
+    return 0;
+  }
+
+  data->stats.transactions++;
+
+  for (size_t i = 0U; i < tx_bufs->count; ++i) {
+    const uint8_t *buf = tx_bufs->buffers[i].buf;
+
+    if ((data->trace_cb != NULL) && (tx_bufs->buffers[i].len > 0U)) {
+      data->trace_cb(target, cmd, buf, tx_bufs->buffers[i].len,
+                     data->trace_user_data);
+    }
+
+    for (size_t j = 0U; j < tx_bufs->buffers[i].len; ++j) {
+      if (cmd) {
+        ssd1351_emul_command(data, buf[j]);
+      } else {
+        ssd1351_emul_data_byte(data, buf[j]);
+      }
+    }
+  }
+
+  return 0;
+}
+
+void emul_ssd1351_set_trace(const struct emul *target,
+                            emul_ssd1351_trace_cb_t cb, void *user_data) {
+  struct ssd1351_emul_data *data = target->data;
+
+  data->trace_cb = cb;
+  data->trace_user_data = user_data;
+}
+
+void emul_ssd1351_get_stats(const struct emul *target,
+                            struct emul_ssd1351_stats *stats) {
+  const struct ssd1351_emul_data *data = target->data;
+
+  *stats = data->stats;
+}
+
+void emul_ssd1351_reset_stats(const struct emul *target) {
+  struct ssd1351_emul_data *data = target->data;
+
+  memset(&data->stats, 0, sizeof(data->stats));
+}
+
+uint16_t emul_ssd1351_get_gddram(const struct emul *target, uint8_t col,
+                                 uint8_t row) {
+  const struct ssd1351_emul_data *data = target->data;
+
+  return data->gddram[row % EMUL_SSD1351_GDDRAM_ROWS]
+                     [col % EMUL_SSD1351_GDDRAM_COLS];
+}
+
+uint16_t emul_ssd1351_get_pixel(const struct emul *target, uint8_t x,
+                                uint8_t y) {
+  const struct ssd1351_emul_data *data = target->data;
+  uint8_t com;
+  uint8_t line;
+  uint16_t color;
+
+  if (!data->display_on || (data->display_mode == SSD1351_CMD_DISPLAYALLOFF)) {
+    return 0U;
+  }
+  if (data->display_mode == SSD1351_CMD_DISPLAYALLON) {
+    return UINT16_MAX;
+  }
+
+  /* Display offset shifts the COM lines, the scan direction maps lines */
+  com = (y + EMUL_SSD1351_GDDRAM_ROWS - data->display_offset) %
+        EMUL_SSD1351_GDDRAM_ROWS;
+  if (com > data->mux_ratio) {
+    return 0U;
+  }
+  line = ((data->remap & SSD1351_REMAP_COM_REVERSE) != 0U)
+             ? data->mux_ratio - com
+             : com;
+
+  color = emul_ssd1351_get_gddram(
+      target,
+      ((data->remap & SSD1351_REMAP_COLUMN) != 0U)
+          ? EMUL_SSD1351_GDDRAM_COLS - 1U - x
+          : x,
+      line + data->startline);
+
+  return (data->display_mode == SSD1351_CMD_INVERTDISPLAY) ? ~color : color;
+}
+
+bool emul_ssd1351_is_display_on(const struct emul *target) {
+  const struct ssd1351_emul_data *data = target->data;
+
+  return data->display_on;
+}
+
+static const struct spi_emul_api ssd1351_emul_api = {
+    .io = ssd1351_emul_io,
+};
+
+static int ssd1351_emul_init(const struct emul *target,
+                             const struct device *parent) {
+  const struct ssd1351_emul_cfg *cfg = target->cfg;
+
+  ARG_UNUSED(parent);
+
+  if (!gpio_is_ready_dt(&cfg->cmd_data_gpio)) {
+    LOG_ERR("CMD/DATA GPIO device not ready");
+    return -ENODEV;
+  }
+
+  ssd1351_emul_power_on_reset(target->data);
+
+  return 0;
+}
+
+#define SSD1351_EMUL(inst)                                                     \
+  static struct ssd1351_emul_data ssd1351_emul_data_##inst;                    \
+  static const struct ssd1351_emul_cfg ssd1351_emul_cfg_##inst = {             \
+      .cmd_data_gpio = GPIO_DT_SPEC_INST_GET(inst, cmd_data_gpios),            \
+  };                                                                           \
+  EMUL_DT_INST_DEFINE(inst, ssd1351_emul_init, &ssd1351_emul_data_##inst,      \
+                      &ssd1351_emul_cfg_##inst, &ssd1351_emul_api, NULL)
+
+DT_INST_FOREACH_STATUS_OKAY(SSD1351_EMUL)
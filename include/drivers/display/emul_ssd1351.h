@@ -0,0 +1,131 @@
+/*
+ * Copyright (c) 2024
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Backend API of the SSD1351 bus emulator
+ *
+ * The emulator decodes the command and data stream the driver sends over an
+ * emulated SPI bus, using the D/C GPIO to tell them apart, and keeps the
+ * controller's 128x128 GDDRAM. Only the 65k colour mode is modelled and the
+ * reset line is not observed.
+ */
+
+#ifndef EMUL_SSD1351_H__
+#define EMUL_SSD1351_H__
+
+#include <zephyr/drivers/emul.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define EMUL_SSD1351_GDDRAM_COLS 128
+#define EMUL_SSD1351_GDDRAM_ROWS 128
+
+/** @brief Bus traffic seen by the emulator */
+struct emul_ssd1351_stats {
+  /** SPI transactions (one per io call) */
+  uint32_t transactions;
+  /** Bytes sent with D/C in command state */
+  uint32_t cmd_bytes;
+  /** Bytes sent with D/C in data state, parameters included */
+  uint32_t data_bytes;
+  /** Pixels stored into GDDRAM */
+  uint32_t pixels;
+  /** SETCOLUMN and SETROW commands */
+  uint32_t window_cmds;
+  /** WRITERAM commands */
+  uint32_t writes;
+};
+
+/**
+ * @brief Callback seeing every buffer sent to the emulator
+ *
+ * Runs from the SPI transfer, before the bytes are decoded, once per buffer
+ * of the transaction.
+ *
+ * @param target Emulator instance
+ * @param cmd Whether D/C was in command state
+ * @param buf Bytes sent
+ * @param len Number of bytes in @p buf
+ * @param user_data Pointer passed to emul_ssd1351_set_trace()
+ */
+typedef void (*emul_ssd1351_trace_cb_t)(const struct emul *target, bool cmd,
+                                        const uint8_t *buf, size_t len,
+                                        void *user_data);
+
+/**
+ * @brief Trace the bus traffic byte by byte
+ *
+ * Lets a test record the exact stream the driver produced, e.g. to compare
+ * it against a golden trace, where the counters only give totals.
+ *
+ * @param target Emulator instance
+ * @param cb Callback, NULL to stop tracing
+ * @param user_data Pointer handed back to @p cb
+ */
+void emul_ssd1351_set_trace(const struct emul *target,
+                            emul_ssd1351_trace_cb_t cb, void *user_data);
+
+/**
+ * @brief Read the traffic counters
+ *
+ * @param target Emulator instance
+ * @param stats Filled with the counters since the last reset
+ */
+void emul_ssd1351_get_stats(const struct emul *target,
+                            struct emul_ssd1351_stats *stats);
+
+/**
+ * @brief Clear the traffic counters
+ *
+ * @param target Emulator instance
+ */
+void emul_ssd1351_reset_stats(const struct emul *target);
+
+/**
+ * @brief Read a GDDRAM cell by controller address
+ *
+ * @param target Emulator instance
+ * @param col Column address
+ * @param row Row address
+ *
+ * @return Pixel as the two bytes were sent, most significant byte first
+ */
+uint16_t emul_ssd1351_get_gddram(const struct emul *target, uint8_t col,
+                                 uint8_t row);
+
+/**
+ * @brief Read a pixel as it appears on the panel
+ *
+ * Applies display on/off and the display modes, start line, display offset,
+ * MUX ratio, column remap and COM scan direction. The colour sequence bit is
+ * not applied, so the value is returned as it was written.
+ *
+ * @param target Emulator instance
+ * @param x Panel column, left to right
+ * @param y Panel row, top to bottom
+ *
+ * @return Visible pixel, 0 for dark pixels
+ */
+uint16_t emul_ssd1351_get_pixel(const struct emul *target, uint8_t x,
+                                uint8_t y);
+
+/**
+ * @brief Whether the panel is lit
+ *
+ * @param target Emulator instance
+ *
+ * @return true after DISPLAYON, false after DISPLAYOFF
+ */
+bool emul_ssd1351_is_display_on(const struct emul *target);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* EMUL_SSD1351_H__ */
@@ -0,0 +1,331 @@
+/*
+ * Copyright (c) 2024
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Extended API of the SSD1351 OLED display driver
+ */
+
+#ifndef SSD1351_DISPLAY_H__
+#define SSD1351_DISPLAY_H__
+
+#include <zephyr/device.h>
+#include <zephyr/drivers/display.h>
+#include <zephyr/kernel.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Vendor pixel format for 8-bit RGB332
+ *
+ * Zephyr has no RGB332 format, this bit lies above the ones it defines.
+ * With CONFIG_SSD1351_RGB332 the driver reports it in the supported pixel
+ * formats, and display_set_pixel_format() with it makes display_write()
+ * behave like ssd1351_write_rgb332(). ssd1351_write_rects(),
+ * ssd1351_fill() and display_read() stay RGB565.
+ */
+#define SSD1351_PIXEL_FORMAT_RGB_332 ((enum display_pixel_format)BIT(15))
+
+/** @brief Bus savings of the tile diff stage */
+struct ssd1351_diff_stats {
+  /** Pixel bytes that were sent to the controller */
+  uint32_t bytes_sent;
+  /** Pixel bytes skipped because GDDRAM already held them */
+  uint32_t bytes_saved;
+};
+
+/**
+ * @brief Callback invoked when the pixel data of a write left the bus
+ *
+ * May be called from interrupt context.
+ *
+ * @param dev SSD1351 device
+ * @param result 0 on success, negative errno of the SPI transfer otherwise
+ * @param user_data Pointer passed at registration
+ */
+typedef void (*ssd1351_write_done_cb_t)(const struct device *dev, int result,
+                                        void *user_data);
+
+/**
+ * @brief Register the completion callback of asynchronous writes
+ *
+ * Writes only return before their pixels are sent while a callback is
+ * registered. Without one they wait for the transfer, so callers that
+ * reuse the buffer right away, like the stock LVGL flush, stay safe.
+ *
+ * @param dev SSD1351 device
+ * @param cb Callback, NULL to unregister
+ * @param user_data Pointer handed back to @p cb
+ *
+ * @retval 0 on success
+ * @retval -ENOTSUP if CONFIG_SSD1351_ASYNC_WRITE is disabled
+ */
+int ssd1351_set_write_done_callback(const struct device *dev,
+                                    ssd1351_write_done_cb_t cb,
+                                    void *user_data);
+
+/**
+ * @brief Wait until no pixel data transfer is in flight
+ *
+ * @param dev SSD1351 device
+ * @param timeout Maximum time to wait
+ *
+ * @retval 0 if the bus is idle; result of the last transfer otherwise
+ * @retval -EAGAIN on timeout
+ */
+int ssd1351_wait_idle(const struct device *dev, k_timeout_t timeout);
+
+/**
+ * @brief Start a frame holding the bus and CS
+ *
+ * Until ssd1351_frame_end(), every transfer keeps CS asserted and the SPI
+ * bus locked, so only the D/C line toggles between commands and pixel data.
+ * The frame runs at the pixel clock, commands included. Only the bus is
+ * held: calls into the driver from other threads go on, and their commands
+ * join the frame. Other devices on the bus wait for the frame to end. A
+ * suspend lets go of the bus, the frame's later writes are deferred.
+ *
+ * @param dev SSD1351 device
+ *
+ * @retval 0 on success
+ * @retval -EALREADY if a frame is already open
+ * @retval -ENOTSUP if CONFIG_SSD1351_FRAME_HOLD_CS is disabled
+ */
+int ssd1351_frame_begin(const struct device *dev);
+
+/**
+ * @brief End the frame started by ssd1351_frame_begin()
+ *
+ * Waits for the last transfer, then releases CS and the bus.
+ *
+ * @param dev SSD1351 device
+ *
+ * @retval 0 on success
+ * @retval -EALREADY if no frame is open
+ * @retval -ENOTSUP if CONFIG_SSD1351_FRAME_HOLD_CS is disabled
+ * @retval -errno of spi_release() otherwise
+ */
+int ssd1351_frame_end(const struct device *dev);
+
+/**
+ * @brief Wait until the panel is up
+ *
+ * With CONFIG_SSD1351_DEFERRED_INIT the panel is brought up from the system
+ * work queue after the device is ready. Until then the driver acts as if
+ * suspended, so callers that need the panel, like a GUI before its first
+ * flush, wait here. Returns at once otherwise.
+ *
+ * @param dev SSD1351 device
+ * @param timeout Maximum time to wait
+ *
+ * @retval 0 if the panel is up
+ * @retval -EAGAIN on timeout
+ * @retval -errno if the bring-up failed
+ */
+int ssd1351_wait_ready(const struct device *dev, k_timeout_t timeout);
+
+/**
+ * @brief Number of bus bytes saved by the register shadow
+ *
+ * Counts command and parameter bytes that were not sent because the
+ * controller already held the requested register value.
+ *
+ * @param dev SSD1351 device
+ *
+ * @return Elided bytes since boot
+ */
+uint32_t ssd1351_get_elided_bytes(const struct device *dev);
+
+/**
+ * @brief Read the counters of the tile diff stage
+ *
+ * @param dev SSD1351 device
+ * @param stats Filled with the counters since boot
+ *
+ * @retval 0 on success
+ * @retval -ENOTSUP if CONFIG_SSD1351_TILE_DIFF is disabled
+ */
+int ssd1351_get_diff_stats(const struct device *dev,
+                           struct ssd1351_diff_stats *stats);
+
+/**
+ * @brief Fill an area with a single colour
+ *
+ * The colour is streamed from a small repeated buffer, so clearing the
+ * screen or painting a large background needs no pixel buffer of the area's
+ * size. Coordinates follow the current orientation like display_write().
+ *
+ * @param dev SSD1351 device
+ * @param x Left edge of the area
+ * @param y Top edge of the area
+ * @param width Width of the area in pixels
+ * @param height Height of the area in pixels
+ * @param color RGB565 colour in CPU byte order
+ *
+ * @retval 0 on success
+ * @retval -EINVAL if the area is empty or does not fit the screen
+ * @retval -errno of the SPI transfer otherwise
+ */
+int ssd1351_fill(const struct device *dev, uint16_t x, uint16_t y,
+                 uint16_t width, uint16_t height, uint16_t color);
+
+/** @brief One area of a batched write, see ssd1351_write_rects() */
+struct ssd1351_rect {
+  /** Left edge of the area */
+  uint16_t x;
+  /** Top edge of the area */
+  uint16_t y;
+  /** Layout of @ref buf, as for display_write() */
+  struct display_buffer_descriptor desc;
+  /** Pixel data in the current pixel format */
+  const void *buf;
+};
+
+/**
+ * @brief Image drawn by the driver while it initializes the panel
+ *
+ * The pixels are read straight from where the image lives, usually flash,
+ * and never copied to RAM. They are RGB565 in bus order, big-endian, either
+ * raw or as runs of three bytes: the run length minus one, then the colour.
+ * Runs carry on from one row to the next.
+ */
+struct ssd1351_splash {
+  /** Width of the image in pixels */
+  uint16_t width;
+  /** Height of the image in pixels */
+  uint16_t height;
+  /** RGB565 colour of the rest of the screen */
+  uint16_t background;
+  /** Whether data holds runs instead of raw pixels */
+  bool rle;
+  /** Length of data in bytes */
+  size_t len;
+  /** Pixel data */
+  const uint8_t *data;
+};
+
+/**
+ * @brief Boot splash, centred on the screen before the panel is switched on
+ *
+ * Defined by the application when CONFIG_SSD1351_BOOT_SPLASH is set. It
+ * stays up until the first write replaces it.
+ */
+extern const struct ssd1351_splash ssd1351_boot_splash;
+
+/**
+ * @brief Write several areas in one go
+ *
+ * Like a display_write() per area, but the areas are sorted and neighbours
+ * that together form a rectangle, side by side with the same rows or
+ * stacked with the same columns, are sent as one window with one pixel
+ * transfer. Overlapping areas keep their order, so the later one wins. The
+ * write done callback runs once, after the last area.
+ *
+ * Meant for callers holding several areas at once. LVGL flushes one area
+ * per call and needs it done before it renders the next into the same
+ * buffer, so the shield's flush path never has a batch to hand over.
+ *
+ * @param dev SSD1351 device
+ * @param rects Areas to write, reordered in place
+ * @param count Number of areas
+ *
+ * @retval 0 on success
+ * @retval -EINVAL if there are no areas or one does not fit the screen
+ * @retval -errno of the SPI transfer otherwise
+ */
+int ssd1351_write_rects(const struct device *dev, struct ssd1351_rect *rects,
+                        size_t count);
+
+/**
+ * @brief Write RGB332 pixels, expanded to RGB565 on the way out
+ *
+ * Like display_write(), but @p buf holds one byte per pixel, red in the
+ * top three bits, then three bits green and two bits blue. The driver
+ * expands the pixels chunk by chunk, so @p buf may be reused as soon as
+ * the call returns, even with CONFIG_SSD1351_ASYNC_WRITE.
+ *
+ * @param dev SSD1351 device
+ * @param x Left edge of the area
+ * @param y Top edge of the area
+ * @param desc Layout of @p buf, with the pitch and size in bytes
+ * @param buf Pixel data
+ *
+ * @retval 0 on success
+ * @retval -ENOTSUP if CONFIG_SSD1351_RGB332 is disabled
+ * @retval -EINVAL if the area is empty or does not fit the screen
+ * @retval -errno of the SPI transfer otherwise
+ */
+int ssd1351_write_rgb332(const struct device *dev, uint16_t x, uint16_t y,
+                         const struct display_buffer_descriptor *desc,
+                         const void *buf);
+
+/**
+ * @brief Scroll the whole screen by moving the display start line
+ *
+ * Content moves by @p lines towards the top of GDDRAM, positive values move
+ * it up in the normal orientation and left in the rotated ones. Later writes
+ * are translated, so logical coordinates keep addressing the visible screen
+ * and only the rows exposed by the scroll need to be written afterwards:
+ * the last @p lines rows (columns when rotated) for a positive value, the
+ * first -@p lines ones for a negative value. The scroll survives orientation
+ * changes.
+ *
+ * @param dev SSD1351 device
+ * @param lines Lines to scroll by, relative to the current position
+ *
+ * @retval 0 on success
+ * @retval -errno of the SPI transfer otherwise
+ */
+int ssd1351_scroll(const struct device *dev, int16_t lines);
+
+/**
+ * @brief Shift the picture against burn-in without redrawing it
+ *
+ * Moves what the panel shows by @p lines along the same axis and in the same
+ * direction as ssd1351_scroll(), through the display offset. GDDRAM and the
+ * logical coordinates of later writes are unchanged, so this costs one
+ * command and no pixel data. Lines shifted off one edge reappear at the
+ * other. The shift is kept across orientation changes and suspend.
+ *
+ * @param dev SSD1351 device
+ * @param lines Lines to shift by, absolute, 0 for none
+ *
+ * @retval 0 on success
+ * @retval -errno of the SPI transfer otherwise
+ */
+int ssd1351_set_pixel_shift(const struct device *dev, int8_t lines);
+
+/**
+ * @brief Scan only a band of the panel, with a slower display clock
+ *
+ * Lowers the MUX ratio so the panel drives only @p lines of the screen from
+ * @p start, along the scroll axis, and leaves the other lines dark. The
+ * display clock is slowed down to CONFIG_SSD1351_LOW_POWER_CLOCKDIV at the
+ * same time. Neither the controller nor GDDRAM is reinitialized, so entering
+ * and leaving this mode costs a few commands.
+ *
+ * Writes outside the band are dropped while the mode is active. Leaving it
+ * writes them back from the shadow framebuffer when there is one, otherwise
+ * the caller has to redraw the screen.
+ *
+ * @param dev SSD1351 device
+ * @param start First line of the band
+ * @param lines Lines in the band, at least 16, or 0 to scan the whole panel
+ *
+ * @retval 0 on success
+ * @retval -EINVAL if the band is too small or off the screen
+ * @retval -errno of the SPI transfer otherwise
+ */
+int ssd1351_set_low_power(const struct device *dev, uint16_t start,
+                          uint16_t lines);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SSD1351_DISPLAY_H__ */
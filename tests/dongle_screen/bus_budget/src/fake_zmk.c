@@ -0,0 +1,90 @@
+/*
+ * Copyright (c) 2024
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * The parts of ZMK the status screen reads from, without keymap, BLE, USB or
+ * the display subsystem. Events go through ZMK's own event manager.
+ */
+
+#include <zephyr/init.h>
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+
+#include <zmk/battery.h>
+#include <zmk/ble.h>
+#include <zmk/display.h>
+#include <zmk/endpoints.h>
+#include <zmk/hid.h>
+#include <zmk/keymap.h>
+
+#include "fake_zmk.h"
+
+LOG_MODULE_REGISTER(zmk, CONFIG_ZMK_LOG_LEVEL);
+
+/* As CONFIG_ZMK_DISPLAY_DEDICATED_THREAD_STACK_SIZE of the shield */
+#define DISPLAY_WORK_Q_STACK_SIZE 4096
+
+K_THREAD_STACK_DEFINE(display_work_q_stack, DISPLAY_WORK_Q_STACK_SIZE);
+static struct k_work_q display_work_q;
+
+static uint8_t layer;
+static struct zmk_endpoint_instance endpoint = {
+    .transport = ZMK_TRANSPORT_USB,
+};
+static uint8_t ble_profile;
+static bool ble_connected;
+static struct zmk_hid_keyboard_report keyboard_report;
+
+void fake_zmk_set_layer(uint8_t index) { layer = index; }
+
+void fake_zmk_set_endpoint(bool ble, uint8_t profile, bool connected) {
+  endpoint.transport = ble ? ZMK_TRANSPORT_BLE : ZMK_TRANSPORT_USB;
+  ble_profile = profile;
+  ble_connected = connected;
+}
+
+void fake_zmk_set_mods(uint8_t mods) { keyboard_report.body.modifiers = mods; }
+
+void fake_zmk_display_drain(void) {
+  k_work_queue_drain(&display_work_q, false);
+}
+
+struct k_work_q *zmk_display_work_q(void) { return &display_work_q; }
+
+bool zmk_display_is_initialized(void) { return true; }
+
+uint8_t zmk_keymap_highest_layer_active(void) { return layer; }
+
+const char *zmk_keymap_layer_name(uint8_t index) {
+  ARG_UNUSED(index);
+
+  return NULL;
+}
+
+struct zmk_endpoint_instance zmk_endpoints_selected(void) { return endpoint; }
+
+int zmk_ble_active_profile_index(void) { return ble_profile; }
+
+bool zmk_ble_active_profile_is_connected(void) { return ble_connected; }
+
+bool zmk_ble_active_profile_is_open(void) { return !ble_connected; }
+
+struct zmk_hid_keyboard_report *zmk_hid_get_keyboard_report(void) {
+  return &keyboard_report;
+}
+
+uint8_t zmk_battery_state_of_charge(void) { return 100; }
+
+/* Up before lvgl.c, the widgets queue their first update while being built */
+static int display_work_q_init(void) {
+  k_work_queue_start(&display_work_q, display_work_q_stack,
+                     K_THREAD_STACK_SIZEOF(display_work_q_stack),
+                     CONFIG_SYSTEM_WORKQUEUE_PRIORITY, NULL);
+
+  return 0;
+}
+
+SYS_INIT(display_work_q_init, APPLICATION, 0);
@@ -0,0 +1,30 @@
+/*
+ * Copyright (c) 2024
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef FAKE_ZMK_H__
+#define FAKE_ZMK_H__
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/*
+ * State behind the ZMK getters the widgets read when an event comes in. Set
+ * it, then raise the event the way ZMK would.
+ */
+
+/** @brief Highest active layer, it has no name */
+void fake_zmk_set_layer(uint8_t index);
+
+/** @brief Selected endpoint and the state of the active BLE profile */
+void fake_zmk_set_endpoint(bool ble, uint8_t profile, bool connected);
+
+/** @brief Modifiers of the keyboard report, polled by the modifier widget */
+void fake_zmk_set_mods(uint8_t mods);
+
+/** @brief Wait until the display work queue ran all widget updates */
+void fake_zmk_display_drain(void);
+
+#endif /* FAKE_ZMK_H__ */
@@ -0,0 +1,207 @@
+/*
+ * Copyright (c) 2024
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <drivers/display/emul_ssd1351.h>
+#include <zephyr/device.h>
+#include <zephyr/drivers/emul.h>
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+
+#include <dt-bindings/zmk/modifiers.h>
+#include <zmk/events/battery_state_changed.h>
+#include <zmk/events/endpoint_changed.h>
+#include <zmk/events/layer_state_changed.h>
+#include <zmk/events/wpm_state_changed.h>
+#include <zmk/split/central.h>
+
+#include <lvgl.h>
+
+#include "custom_status_screen.h"
+#include "fake_zmk.h"
+
+/*
+ * Bus cost of the shield's status screen reacting to a ZMK event. Every
+ * test starts right after a full redraw, which leaves the window on the
+ * lower 64 row stripe. The screen is rotated by the controller, so a row
+ * range of LVGL lands in SETCOLUMN and a column range in SETROW.
+ *
+ * An area costs its pixels, 2 bytes each, and a window setup: SETCOLUMN and
+ * SETROW with two parameters each and WRITERAM, 7 bytes in 6 transactions
+ * with the pixels. A register that already holds the value is not sent, 3
+ * bytes and 2 transactions less.
+ *
+ * Labels are sized by the fonts: 5 pixels a glyph of the 12 pixel high
+ * default font and 12 a glyph of the 20 pixel high large one, 1 pixel of
+ * letter and line space.
+ */
+struct bus_budget {
+  uint32_t bytes;
+  uint32_t transactions;
+  uint32_t window_cmds;
+};
+
+/*
+ * Pixel bytes may be off by this much, e.g. after a font update. Window
+ * setups and transactions must match.
+ */
+#define BUDGET_TOLERANCE_PCT 10
+
+/*
+ * 128x128 in two 64 row stripes, the draw buffer holds half the screen.
+ * Both stripes span all columns, which SETROW already holds.
+ */
+static const struct bus_budget full_budget = {32776, 8, 2};
+/* "42" to "57", an 11x12 label */
+static const struct bus_budget wpm_budget = {271, 6, 2};
+/* Layer 0 to 3, a 12x20 label */
+static const struct bus_budget layer_budget = {487, 6, 2};
+/*
+ * No modifier to shift, a 12x20 label growing from nothing. It is centered
+ * again after it grew, so the area is 6 pixels wider: 18x20.
+ */
+static const struct bus_budget mod_budget = {727, 6, 2};
+/* USB to BLE profile 2, labels of 29x25 and 5x12 */
+static const struct bus_budget output_budget = {1584, 12, 4};
+/*
+ * 80% to 9% on the first peripheral. The battery moves to the foreground,
+ * which redraws the 128x20 box across the screen, SETROW holds that already.
+ */
+static const struct bus_budget battery_budget = {5124, 4, 1};
+/* WPM and modifier labels in one refresh, as while typing */
+static const struct bus_budget typing_budget = {998, 12, 4};
+
+/* Period of the modifier widget's timer in mod_status.c */
+#define MOD_STATUS_PERIOD_MS 100
+
+static const struct emul *const panel = EMUL_DT_GET(DT_NODELABEL(ssd1351));
+
+static void refresh(void) { lv_refr_now(NULL); }
+
+/* Let the widgets pick up everything raised so far and redraw the screen */
+static void redraw(void) {
+  fake_zmk_display_drain();
+  lv_obj_invalidate(lv_scr_act());
+  refresh();
+  emul_ssd1351_reset_stats(panel);
+}
+
+static void set_mods(uint8_t mods) {
+  fake_zmk_set_mods(mods);
+  k_sleep(K_MSEC(MOD_STATUS_PERIOD_MS * 3 / 2));
+}
+
+static void check_budget(const char *name, const struct bus_budget *budget) {
+  struct emul_ssd1351_stats stats;
+  uint32_t bytes;
+  uint32_t slack = budget->bytes * BUDGET_TOLERANCE_PCT / 100U;
+
+  fake_zmk_display_drain();
+  refresh();
+  emul_ssd1351_get_stats(panel, &stats);
+  bytes = stats.cmd_bytes + stats.data_bytes;
+
+  TC_PRINT("%s: %u bytes, %u transactions, %u window commands, %u pixels\n",
+           name, bytes, stats.transactions, stats.window_cmds, stats.pixels);
+
+  zassert_true(stats.pixels > 0U, "%s sent nothing", name);
+  zassert_within(bytes, budget->bytes, slack, "%s: %u bytes, expected %u",
+                 name, bytes, budget->bytes);
+  zassert_equal(stats.transactions, budget->transactions,
+                "%s: %u transactions, expected %u", name, stats.transactions,
+                budget->transactions);
+  zassert_equal(stats.window_cmds, budget->window_cmds,
+                "%s: %u window commands, expected %u", name,
+                stats.window_cmds, budget->window_cmds);
+}
+
+ZTEST(dongle_screen_bus_budget, test_idle_refresh_is_free) {
+  struct emul_ssd1351_stats stats;
+
+  refresh();
+  emul_ssd1351_get_stats(panel, &stats);
+
+  zassert_equal(stats.transactions, 0U);
+}
+
+ZTEST(dongle_screen_bus_budget, test_full_redraw) {
+  lv_obj_invalidate(lv_scr_act());
+  check_budget("full redraw", &full_budget);
+}
+
+ZTEST(dongle_screen_bus_budget, test_wpm) {
+  raise_zmk_wpm_state_changed((struct zmk_wpm_state_changed){.state = 42});
+  redraw();
+
+  raise_zmk_wpm_state_changed((struct zmk_wpm_state_changed){.state = 57});
+  check_budget("wpm", &wpm_budget);
+}
+
+ZTEST(dongle_screen_bus_budget, test_layer) {
+  fake_zmk_set_layer(3);
+  raise_layer_state_changed(3, true);
+  check_budget("layer", &layer_budget);
+}
+
+ZTEST(dongle_screen_bus_budget, test_modifiers) {
+  set_mods(MOD_LSFT);
+  check_budget("modifiers", &mod_budget);
+}
+
+ZTEST(dongle_screen_bus_budget, test_output) {
+  fake_zmk_set_endpoint(true, 1, true);
+  raise_zmk_endpoint_changed((struct zmk_endpoint_changed){
+      .endpoint = {.transport = ZMK_TRANSPORT_BLE}});
+  check_budget("output", &output_budget);
+}
+
+ZTEST(dongle_screen_bus_budget, test_battery) {
+  raise_zmk_peripheral_battery_state_changed(
+      (struct zmk_peripheral_battery_state_changed){.source = 0,
+                                                    .state_of_charge = 80});
+  redraw();
+
+  raise_zmk_peripheral_battery_state_changed(
+      (struct zmk_peripheral_battery_state_changed){.source = 0,
+                                                    .state_of_charge = 9});
+  check_budget("battery", &battery_budget);
+}
+
+ZTEST(dongle_screen_bus_budget, test_typing) {
+  raise_zmk_wpm_state_changed((struct zmk_wpm_state_changed){.state = 60});
+  redraw();
+
+  raise_zmk_wpm_state_changed((struct zmk_wpm_state_changed){.state = 61});
+  set_mods(MOD_LSFT);
+  check_budget("typing", &typing_budget);
+}
+
+static void *bus_budget_setup(void) {
+  lv_scr_load(zmk_display_status_screen());
+
+  for (uint8_t i = 0U; i < ZMK_SPLIT_CENTRAL_PERIPHERAL_COUNT; i++) {
+    raise_zmk_peripheral_battery_state_changed(
+        (struct zmk_peripheral_battery_state_changed){.source = i,
+                                                      .state_of_charge = 100});
+  }
+
+  return NULL;
+}
+
+static void bus_budget_before(void *fixture) {
+  ARG_UNUSED(fixture);
+
+  /* Back to layer 0 over USB without modifiers, then a known window */
+  fake_zmk_set_layer(0);
+  raise_layer_state_changed(0, true);
+  fake_zmk_set_endpoint(false, 0, false);
+  raise_zmk_endpoint_changed((struct zmk_endpoint_changed){
+      .endpoint = {.transport = ZMK_TRANSPORT_USB}});
+  set_mods(0);
+  redraw();
+}
+
+ZTEST_SUITE(dongle_screen_bus_budget, NULL, bus_budget_setup,
+            bus_budget_before, NULL, NULL);
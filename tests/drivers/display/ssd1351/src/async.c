@@ -0,0 +1,181 @@
+/*
+ * Copyright (c) 2024
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+
+#include <drivers/display/ssd1351.h>
+#include <zephyr/device.h>
+#include <zephyr/drivers/display.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/ztest.h>
+
+#include "test_spi.h"
+
+#define AREA_SIZE 32
+#define AREA_BYTES (AREA_SIZE * AREA_SIZE * 2)
+#define WRITES 8
+
+static const struct device *const disp = DEVICE_DT_GET(DT_NODELABEL(ssd1351));
+static const struct device *const spi = DEVICE_DT_GET(DT_NODELABEL(test_spi));
+
+static uint8_t area_bufs[2][AREA_BYTES];
+static atomic_t done_count;
+static int done_result;
+
+static const struct display_buffer_descriptor area_desc = {
+    .buf_size = AREA_BYTES,
+    .width = AREA_SIZE,
+    .height = AREA_SIZE,
+    .pitch = AREA_SIZE,
+};
+
+static void write_done(const struct device *dev, int result, void *user_data) {
+  ARG_UNUSED(dev);
+  ARG_UNUSED(user_data);
+
+  done_result = result;
+  atomic_inc(&done_count);
+}
+
+static void *ssd1351_async_setup(void) {
+  zassert_true(device_is_ready(disp), "Display not ready");
+
+  /* No single colour, the driver would stream that from its fill row */
+  for (size_t i = 0U; i < AREA_BYTES; ++i) {
+    area_bufs[0][i] = i;
+    area_bufs[1][i] = ~i;
+  }
+
+  zassert_ok(ssd1351_set_write_done_callback(disp, write_done, NULL));
+
+  return NULL;
+}
+
+static void ssd1351_async_before(void *fixture) {
+  ARG_UNUSED(fixture);
+
+  zassert_ok(ssd1351_wait_idle(disp, K_FOREVER));
+  test_spi_reset_stats(spi);
+  atomic_set(&done_count, 0);
+  done_result = -EINPROGRESS;
+}
+
+static void ssd1351_async_after(void *fixture) {
+  ARG_UNUSED(fixture);
+
+  /* Leave no transfer behind for the next test to wait on */
+  test_spi_set_manual(spi, false);
+  (void)test_spi_complete(spi);
+}
+
+ZTEST(ssd1351_async, test_write_returns_before_pixels_are_sent) {
+  struct test_spi_stats stats;
+
+  test_spi_set_manual(spi, true);
+  zassert_ok(display_write(disp, 0, 0, &area_desc, area_bufs[0]));
+
+  zassert_true(test_spi_is_busy(spi), "Write returned without a transfer");
+  test_spi_get_stats(spi, &stats);
+  zassert_equal(stats.pixel_bytes, 0, "Pixels left before the write returned");
+  zassert_equal(atomic_get(&done_count), 0, "Done before the transfer ended");
+
+  zassert_ok(test_spi_complete(spi));
+
+  test_spi_get_stats(spi, &stats);
+  zassert_equal(stats.pixel_bytes, AREA_BYTES);
+  zassert_equal(atomic_get(&done_count), 1);
+  zassert_ok(done_result);
+  zassert_equal(stats.errors, 0, "Bus used while the transfer was in flight");
+}
+
+ZTEST(ssd1351_async, test_done_once_per_write) {
+  struct test_spi_stats stats;
+
+  /* Each write waits for the transfer of the one before */
+  for (int i = 0; i < WRITES; ++i) {
+    zassert_ok(display_write(disp, (i % 4) * AREA_SIZE, (i / 4) * AREA_SIZE,
+                             &area_desc, area_bufs[i % 2]));
+  }
+  zassert_ok(ssd1351_wait_idle(disp, K_FOREVER));
+  zassert_equal(atomic_get(&done_count), WRITES);
+
+  /* And nothing comes in late */
+  k_sleep(K_MSEC(10));
+  zassert_equal(atomic_get(&done_count), WRITES);
+
+  test_spi_get_stats(spi, &stats);
+  zassert_equal(stats.pixel_bytes, WRITES * AREA_BYTES);
+  zassert_equal(stats.errors, 0, "Bus used while a transfer was in flight");
+}
+
+ZTEST(ssd1351_async, test_done_once_per_solid_or_strided_write) {
+  static uint8_t solid[AREA_BYTES];
+  const struct display_buffer_descriptor strided = {
+      .buf_size = AREA_BYTES,
+      .width = AREA_SIZE / 2,
+      .height = AREA_SIZE,
+      .pitch = AREA_SIZE,
+  };
+
+  /* Streamed from the fill row */
+  memset(solid, 0x5A, sizeof(solid));
+  zassert_ok(display_write(disp, 0, 0, &area_desc, solid));
+  zassert_ok(ssd1351_wait_idle(disp, K_FOREVER));
+  zassert_equal(atomic_get(&done_count), 1);
+
+  /* One scatter entry per row */
+  zassert_ok(display_write(disp, 0, 0, &strided, area_bufs[0]));
+  zassert_ok(ssd1351_wait_idle(disp, K_FOREVER));
+  zassert_equal(atomic_get(&done_count), 2);
+  zassert_ok(done_result);
+}
+
+static void fail_transfer(struct k_timer *timer) {
+  ARG_UNUSED(timer);
+
+  (void)test_spi_fail(spi, -EIO);
+}
+
+static K_TIMER_DEFINE(fail_timer, fail_transfer, NULL);
+
+ZTEST(ssd1351_async, test_failed_transfer_resends_window) {
+  struct test_spi_stats stats;
+
+  /* Same window twice, the second write would skip SETCOLUMN and SETROW */
+  test_spi_set_manual(spi, true);
+  zassert_ok(display_write(disp, 0, 0, &area_desc, area_bufs[0]));
+  test_spi_reset_stats(spi);
+
+  /* The first transfer fails while the second write waits for the bus */
+  k_timer_start(&fail_timer, K_MSEC(1), K_NO_WAIT);
+  test_spi_set_manual(spi, false);
+  zassert_ok(display_write(disp, 0, 0, &area_desc, area_bufs[1]));
+  zassert_ok(ssd1351_wait_idle(disp, K_FOREVER));
+
+  test_spi_get_stats(spi, &stats);
+  zassert_equal(stats.cmd_bytes, 3, "Window not set up again after the failure");
+  zassert_equal(stats.pixel_bytes, AREA_BYTES);
+  zassert_equal(stats.errors, 0);
+}
+
+ZTEST(ssd1351_async, test_write_without_callback_blocks) {
+  struct test_spi_stats stats;
+
+  /* Like lvgl.c's stock flush, which reuses the buffer once the write returns */
+  zassert_ok(ssd1351_set_write_done_callback(disp, NULL, NULL));
+  zassert_ok(display_write(disp, 0, 0, &area_desc, area_bufs[0]));
+
+  zassert_false(test_spi_is_busy(spi), "Write returned during the transfer");
+  test_spi_get_stats(spi, &stats);
+  zassert_equal(stats.pixel_bytes, AREA_BYTES);
+  zassert_equal(atomic_get(&done_count), 0);
+
+  zassert_ok(ssd1351_set_write_done_callback(disp, write_done, NULL));
+}
+
+ZTEST_SUITE(ssd1351_async, NULL, ssd1351_async_setup, ssd1351_async_before,
+            ssd1351_async_after, NULL);
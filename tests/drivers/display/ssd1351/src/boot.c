@@ -0,0 +1,81 @@
+/*
+ * Copyright (c) 2024
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <drivers/display/ssd1351.h>
+#include <zephyr/device.h>
+#include <zephyr/init.h>
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+
+#include "test_spi.h"
+
+/* Reset sleeps of ssd1351_reset() or the deferred bring-up: 1 + 10 + 10 ms */
+#define RESET_US 21000
+/* What the init thread may spend in the driver when the panel comes up later */
+#define DEFERRED_INIT_MAX_US 1000
+
+static const struct device *const disp = DEVICE_DT_GET(DT_NODELABEL(ssd1351));
+static const struct device *const spi = DEVICE_DT_GET(DT_NODELABEL(test_spi));
+
+/* SYS_INIT() takes a literal priority, stamp right before and after the panel */
+BUILD_ASSERT(CONFIG_DISPLAY_INIT_PRIORITY > 84 &&
+                 CONFIG_DISPLAY_INIT_PRIORITY < 86,
+             "Move the stamps around the display init priority");
+
+static uint32_t display_init_start;
+static uint32_t display_init_end;
+
+static int stamp_display_init_start(void) {
+  display_init_start = k_cycle_get_32();
+
+  return 0;
+}
+
+SYS_INIT(stamp_display_init_start, POST_KERNEL, 84);
+
+static int stamp_display_init_end(void) {
+  display_init_end = k_cycle_get_32();
+
+  return 0;
+}
+
+SYS_INIT(stamp_display_init_end, POST_KERNEL, 86);
+
+#ifdef CONFIG_SSD1351_DEFERRED_INIT
+/* The other suites write to a panel that is up */
+static int wait_panel_up(void) {
+  return ssd1351_wait_ready(disp, K_FOREVER);
+}
+
+SYS_INIT(wait_panel_up, APPLICATION, 0);
+#endif
+
+ZTEST(ssd1351_boot, test_boot_to_first_pixel) {
+  uint32_t blocked_us =
+      k_cyc_to_us_floor32(display_init_end - display_init_start);
+  uint32_t first_pixel_us =
+      k_cyc_to_us_floor32(test_spi_first_pixel_cycle(spi));
+
+  TC_PRINT("init thread blocked %u us, first pixel %u us after boot\n",
+           blocked_us, first_pixel_us);
+
+  zassert_not_equal(test_spi_first_pixel_cycle(spi), 0U,
+                    "panel was never cleared");
+  /* The reset pulse is the floor either way, the clear follows it */
+  zassert_true(first_pixel_us >= RESET_US, "%u us", first_pixel_us);
+
+  if (IS_ENABLED(CONFIG_SSD1351_DEFERRED_INIT)) {
+    zassert_true(blocked_us < DEFERRED_INIT_MAX_US, "%u us", blocked_us);
+    zassert_true(test_spi_first_pixel_cycle(spi) > display_init_end,
+                 "pixels sent while the init thread ran the driver");
+  } else {
+    zassert_true(blocked_us >= RESET_US, "%u us", blocked_us);
+    zassert_true(test_spi_first_pixel_cycle(spi) <= display_init_end,
+                 "pixels sent after the driver init");
+  }
+}
+
+ZTEST_SUITE(ssd1351_boot, NULL, NULL, NULL, NULL, NULL);
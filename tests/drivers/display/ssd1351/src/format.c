@@ -0,0 +1,78 @@
+/*
+ * Copyright (c) 2024
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <drivers/display/ssd1351.h>
+#include <zephyr/device.h>
+#include <zephyr/drivers/display.h>
+#include <zephyr/ztest.h>
+
+#include "test_spi.h"
+
+#define AREA_SIZE 16
+#define AREA_PIXELS (AREA_SIZE * AREA_SIZE)
+
+static const struct device *const disp = DEVICE_DT_GET(DT_NODELABEL(ssd1351));
+static const struct device *const spi = DEVICE_DT_GET(DT_NODELABEL(test_spi));
+
+static uint8_t area_buf[AREA_PIXELS];
+
+static const struct display_buffer_descriptor area_desc = {
+    .buf_size = AREA_PIXELS,
+    .width = AREA_SIZE,
+    .height = AREA_SIZE,
+    .pitch = AREA_SIZE,
+};
+
+static void *ssd1351_format_setup(void) {
+  zassert_true(device_is_ready(disp), "Display not ready");
+
+  /* No single colour, the driver would stream that from its fill row */
+  for (size_t i = 0U; i < sizeof(area_buf); ++i) {
+    area_buf[i] = i;
+  }
+
+  return NULL;
+}
+
+static void ssd1351_format_after(void *fixture) {
+  ARG_UNUSED(fixture);
+
+  zassert_ok(display_set_pixel_format(disp, PIXEL_FORMAT_RGB_565));
+}
+
+ZTEST(ssd1351_format, test_rgb332_in_capabilities) {
+  struct display_capabilities caps;
+
+  display_get_capabilities(disp, &caps);
+  zassert_equal(caps.supported_pixel_formats,
+                PIXEL_FORMAT_RGB_565 | SSD1351_PIXEL_FORMAT_RGB_332);
+  zassert_equal(caps.current_pixel_format, PIXEL_FORMAT_RGB_565);
+
+  zassert_ok(display_set_pixel_format(disp, SSD1351_PIXEL_FORMAT_RGB_332));
+  display_get_capabilities(disp, &caps);
+  zassert_equal(caps.current_pixel_format, SSD1351_PIXEL_FORMAT_RGB_332);
+
+  zassert_equal(display_set_pixel_format(disp, PIXEL_FORMAT_RGB_888),
+                -ENOTSUP);
+}
+
+ZTEST(ssd1351_format, test_rgb332_display_write) {
+  struct test_spi_stats stats;
+
+  zassert_ok(display_set_pixel_format(disp, SSD1351_PIXEL_FORMAT_RGB_332));
+  test_spi_reset_stats(spi);
+
+  zassert_ok(display_write(disp, 0, 0, &area_desc, area_buf));
+  zassert_ok(ssd1351_wait_idle(disp, K_FOREVER));
+
+  /* One byte per pixel in, RGB565 on the bus */
+  test_spi_get_stats(spi, &stats);
+  zassert_equal(stats.pixel_bytes, AREA_PIXELS * 2);
+  zassert_equal(stats.errors, 0);
+}
+
+ZTEST_SUITE(ssd1351_format, NULL, ssd1351_format_setup, NULL,
+            ssd1351_format_after, NULL);
@@ -0,0 +1,228 @@
+/*
+ * Copyright (c) 2024
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <drivers/display/ssd1351.h>
+#include <zephyr/device.h>
+#include <zephyr/drivers/display.h>
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+
+#include "test_spi.h"
+
+/* Areas of a status screen refresh: a label, a symbol and the bottom row */
+static const struct {
+  uint16_t x;
+  uint16_t y;
+  uint16_t width;
+  uint16_t height;
+} refresh_areas[] = {
+    {10, 10, 40, 12},
+    {34, 72, 60, 20},
+    {0, 108, 128, 20},
+};
+
+/* Clocks of the overlay, falling back like the driver does */
+#define PANEL_NODE DT_NODELABEL(ssd1351)
+#define CMD_HZ                                                                 \
+  DT_PROP_OR(PANEL_NODE, command_frequency,                                    \
+             DT_PROP(PANEL_NODE, spi_max_frequency))
+#define PIXEL_HZ                                                               \
+  DT_PROP_OR(PANEL_NODE, pixel_frequency,                                      \
+             DT_PROP(PANEL_NODE, spi_max_frequency))
+#define BUS_US(bytes, hz) ((uint32_t)((uint64_t)(bytes) * 8U * 1000000U / (hz)))
+
+/*
+ * No two areas share a column or row range, so each gets a full window:
+ * SETCOLUMN and SETROW with two parameters each and WRITERAM, 7 bytes in 6
+ * transactions with the pixels. Outside of a frame the commands go out at
+ * the command clock and the pixels at the pixel clock, two switches an area.
+ */
+#define WINDOW_BYTES 7
+#define WINDOW_TRANSACTIONS 6
+#define REFRESH_TRANSACTIONS (ARRAY_SIZE(refresh_areas) * WINDOW_TRANSACTIONS)
+#define REFRESH_CMD_BYTES (ARRAY_SIZE(refresh_areas) * WINDOW_BYTES)
+#define REFRESH_RECONFIGS (ARRAY_SIZE(refresh_areas) * 2)
+
+static const struct device *const disp = DEVICE_DT_GET(DT_NODELABEL(ssd1351));
+static const struct device *const spi = DEVICE_DT_GET(DT_NODELABEL(test_spi));
+
+static uint8_t area_buf[128 * 20 * 2];
+
+static uint32_t refresh_pixel_bytes(void) {
+  uint32_t bytes = 0U;
+
+  for (size_t i = 0U; i < ARRAY_SIZE(refresh_areas); ++i) {
+    bytes += refresh_areas[i].width * refresh_areas[i].height * 2U;
+  }
+
+  return bytes;
+}
+
+static void write_refresh(void) {
+  for (size_t i = 0U; i < ARRAY_SIZE(refresh_areas); ++i) {
+    const struct display_buffer_descriptor desc = {
+        .buf_size = sizeof(area_buf),
+        .width = refresh_areas[i].width,
+        .height = refresh_areas[i].height,
+        .pitch = refresh_areas[i].width,
+    };
+
+    zassert_ok(display_write(disp, refresh_areas[i].x, refresh_areas[i].y,
+                             &desc, area_buf));
+  }
+  zassert_ok(ssd1351_wait_idle(disp, K_FOREVER));
+}
+
+static void print_stats(const char *name, const struct test_spi_stats *stats) {
+  TC_PRINT("%s: %u transactions, %u CS cycles, %u reconfigurations, "
+           "%u bytes, %u us on the bus\n",
+           name, stats->transactions, stats->cs_cycles, stats->reconfigs,
+           stats->cmd_bytes + stats->data_bytes, stats->bus_us);
+}
+
+static void *ssd1351_frame_setup(void) {
+  zassert_true(device_is_ready(disp), "Display not ready");
+
+  for (size_t i = 0U; i < sizeof(area_buf); ++i) {
+    area_buf[i] = i * 7U;
+  }
+
+  return NULL;
+}
+
+static void ssd1351_frame_before(void *fixture) {
+  ARG_UNUSED(fixture);
+
+  /* Same register cache and bus configuration before every measurement */
+  write_refresh();
+  test_spi_reset_stats(spi);
+}
+
+ZTEST(ssd1351_frame, test_refresh_without_frame) {
+  uint32_t pixel_bytes = refresh_pixel_bytes();
+  struct test_spi_stats stats;
+
+  write_refresh();
+
+  test_spi_get_stats(spi, &stats);
+  print_stats("Without frame", &stats);
+  zassert_equal(stats.transactions, REFRESH_TRANSACTIONS);
+  zassert_equal(stats.cs_cycles, REFRESH_TRANSACTIONS);
+  zassert_equal(stats.reconfigs, REFRESH_RECONFIGS);
+  zassert_equal(stats.cmd_bytes + stats.data_bytes,
+                REFRESH_CMD_BYTES + pixel_bytes);
+  zassert_equal(stats.bus_us, BUS_US(REFRESH_CMD_BYTES, CMD_HZ) +
+                                  BUS_US(pixel_bytes, PIXEL_HZ));
+  zassert_equal(stats.errors, 0);
+}
+
+ZTEST(ssd1351_frame, test_refresh_in_one_frame) {
+  uint32_t bytes = REFRESH_CMD_BYTES + refresh_pixel_bytes();
+  struct test_spi_stats stats;
+
+  Z_TEST_SKIP_IFNDEF(CONFIG_SSD1351_FRAME_HOLD_CS);
+
+  zassert_ok(ssd1351_frame_begin(disp));
+  write_refresh();
+  zassert_ok(ssd1351_frame_end(disp));
+
+  test_spi_get_stats(spi, &stats);
+  print_stats("In one frame", &stats);
+  zassert_equal(stats.transactions, REFRESH_TRANSACTIONS);
+  zassert_equal(stats.cs_cycles, 1, "CS went up within the frame");
+  zassert_equal(stats.reconfigs, 1, "Clock changed within the frame");
+  zassert_equal(stats.cmd_bytes + stats.data_bytes, bytes);
+  zassert_equal(stats.bus_us, BUS_US(bytes, PIXEL_HZ),
+                "Frame not at the pixel clock");
+  zassert_equal(stats.errors, 0);
+
+  /* The bus is free again for writes outside of a frame */
+  write_refresh();
+  test_spi_get_stats(spi, &stats);
+  zassert_equal(stats.cs_cycles, 1 + REFRESH_TRANSACTIONS);
+  zassert_equal(stats.errors, 0, "Bus still locked after the frame");
+}
+
+#ifdef CONFIG_SSD1351_FRAME_HOLD_CS
+K_THREAD_STACK_DEFINE(setter_stack, 1024);
+static struct k_thread setter_thread;
+
+/* Like the pixel shift work, which runs on another thread than LVGL */
+static void shift_picture(void *p1, void *p2, void *p3) {
+  ARG_UNUSED(p1);
+  ARG_UNUSED(p2);
+  ARG_UNUSED(p3);
+
+  zassert_ok(ssd1351_set_pixel_shift(disp, 1));
+  zassert_ok(ssd1351_set_pixel_shift(disp, 0));
+}
+#endif
+
+ZTEST(ssd1351_frame, test_setter_during_frame) {
+  struct test_spi_stats stats;
+
+  Z_TEST_SKIP_IFNDEF(CONFIG_SSD1351_FRAME_HOLD_CS);
+
+#ifdef CONFIG_SSD1351_FRAME_HOLD_CS
+  zassert_ok(ssd1351_frame_begin(disp));
+  write_refresh();
+
+  k_thread_create(&setter_thread, setter_stack,
+                  K_THREAD_STACK_SIZEOF(setter_stack), shift_picture, NULL,
+                  NULL, NULL, K_PRIO_PREEMPT(0), 0, K_NO_WAIT);
+  zassert_ok(k_thread_join(&setter_thread, K_MSEC(10)),
+             "Setter blocked by the open frame");
+
+  write_refresh();
+  zassert_ok(ssd1351_frame_end(disp));
+
+  test_spi_get_stats(spi, &stats);
+  /* DISPLAYOFFSET twice, one parameter each */
+  zassert_equal(stats.transactions, 2 * REFRESH_TRANSACTIONS + 4);
+  zassert_equal(stats.cs_cycles, 1, "Setter commands left the frame");
+  zassert_equal(stats.errors, 0);
+#endif
+}
+
+ZTEST(ssd1351_frame, test_command_clock) {
+  struct test_spi_stats stats;
+
+  /* Outside of a frame, window commands and setters use command-frequency */
+  write_refresh();
+  zassert_ok(display_set_brightness(disp, 0x40));
+  zassert_ok(display_set_brightness(disp, 0xFF));
+  test_spi_get_stats(spi, &stats);
+  TC_PRINT("Commands outside of a frame at %u Hz\n", stats.cmd_max_frequency);
+  zassert_equal(stats.cmd_max_frequency, CMD_HZ);
+
+  if (!IS_ENABLED(CONFIG_SSD1351_FRAME_HOLD_CS)) {
+    return;
+  }
+
+  /* A frame has one spi_config, the commands in it go out at pixel-frequency */
+  test_spi_reset_stats(spi);
+  zassert_ok(ssd1351_frame_begin(disp));
+  write_refresh();
+  zassert_ok(display_set_brightness(disp, 0x40));
+  zassert_ok(ssd1351_frame_end(disp));
+  zassert_ok(display_set_brightness(disp, 0xFF));
+
+  test_spi_get_stats(spi, &stats);
+  TC_PRINT("Commands inside a frame at %u Hz\n", stats.cmd_max_frequency);
+  zassert_equal(stats.cmd_max_frequency, PIXEL_HZ);
+}
+
+ZTEST(ssd1351_frame, test_frame_not_nested) {
+  Z_TEST_SKIP_IFNDEF(CONFIG_SSD1351_FRAME_HOLD_CS);
+
+  zassert_ok(ssd1351_frame_begin(disp));
+  zassert_equal(ssd1351_frame_begin(disp), -EALREADY);
+  zassert_ok(ssd1351_frame_end(disp));
+  zassert_equal(ssd1351_frame_end(disp), -EALREADY);
+}
+
+ZTEST_SUITE(ssd1351_frame, NULL, ssd1351_frame_setup, ssd1351_frame_before,
+            NULL, NULL);
@@ -0,0 +1,147 @@
+/*
+ * Copyright (c) 2024
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <drivers/display/ssd1351.h>
+#include <zephyr/device.h>
+#include <zephyr/drivers/display.h>
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+
+#include "test_spi.h"
+
+/*
+ * A full redraw the way LVGL does it, for each stripe height the shield's
+ * DONGLE_SCREEN_STRIPE_ROWS can pick. lvgl.c sizes the draw buffers in
+ * percent of the screen, which leaves 15 and 7 rows for the two smallest.
+ * Each stripe is rendered, which the test stands in for with a busy wait
+ * per row, then flushed. LVGL waits for the previous flush before it
+ * flushes the next stripe, and with one buffer also before it renders into
+ * it again.
+ */
+#define SCREEN_ROWS 128
+#define ROW_BYTES (128 * 2)
+#define SCREEN_BYTES (SCREEN_ROWS * ROW_BYTES)
+/* About the bus time of a row at 16 MHz */
+#define RENDER_US_PER_ROW 125
+#define RENDER_US (SCREEN_ROWS * RENDER_US_PER_ROW)
+
+#define PANEL_NODE DT_NODELABEL(ssd1351)
+#define PIXEL_HZ                                                               \
+  DT_PROP_OR(PANEL_NODE, pixel_frequency,                                      \
+             DT_PROP(PANEL_NODE, spi_max_frequency))
+#define PIXEL_BUS_US ((uint32_t)((uint64_t)SCREEN_BYTES * 8U * 1000000U / PIXEL_HZ))
+/*
+ * Window commands of a stripe, at most 7 bytes at the command clock, plus
+ * the rounding of each transfer and busy wait to whole microseconds
+ */
+#define STRIPE_SLACK_US 20
+
+static const uint16_t stripe_rows[] = {128, 64, 32, 15, 7};
+
+static const struct device *const disp = DEVICE_DT_GET(DT_NODELABEL(ssd1351));
+static const struct device *const spi = DEVICE_DT_GET(DT_NODELABEL(test_spi));
+
+static uint8_t draw_bufs[2][SCREEN_BYTES];
+
+static void render(uint8_t *buf, uint16_t rows, int stripe) {
+  for (size_t i = 0U; i < rows * ROW_BYTES; ++i) {
+    buf[i] = i + stripe;
+  }
+  k_busy_wait(rows * RENDER_US_PER_ROW);
+}
+
+/* Time of a full redraw in stripes of the given rows, one or two buffers */
+static uint32_t redraw_us(uint16_t rows, int buffers) {
+  uint32_t start = k_cycle_get_32();
+  int stripe = 0;
+
+  for (uint16_t y = 0U; y < SCREEN_ROWS; y += rows, ++stripe) {
+    uint8_t *buf = draw_bufs[stripe % buffers];
+    const struct display_buffer_descriptor desc = {
+        .buf_size = sizeof(draw_bufs[0]),
+        .width = 128,
+        .height = MIN(rows, SCREEN_ROWS - y),
+        .pitch = 128,
+    };
+
+    if (buffers == 1) {
+      zassert_ok(ssd1351_wait_idle(disp, K_FOREVER));
+    }
+    render(buf, desc.height, stripe);
+    zassert_ok(ssd1351_wait_idle(disp, K_FOREVER));
+    zassert_ok(display_write(disp, 0, y, &desc, buf));
+  }
+  zassert_ok(ssd1351_wait_idle(disp, K_FOREVER));
+
+  return k_cyc_to_us_floor32(k_cycle_get_32() - start);
+}
+
+#ifdef CONFIG_SSD1351_ASYNC_WRITE
+/* Writes only return early while a callback is registered */
+static void write_done(const struct device *dev, int result, void *user_data) {
+  ARG_UNUSED(dev);
+  ARG_UNUSED(result);
+  ARG_UNUSED(user_data);
+}
+#endif
+
+static void *ssd1351_pipeline_setup(void) {
+  zassert_true(device_is_ready(disp), "Display not ready");
+#ifdef CONFIG_SSD1351_ASYNC_WRITE
+  zassert_ok(ssd1351_set_write_done_callback(disp, write_done, NULL));
+#endif
+
+  return NULL;
+}
+
+ZTEST(ssd1351_pipeline, test_redraw_time_by_stripe_rows) {
+  const char *path =
+      IS_ENABLED(CONFIG_SSD1351_ASYNC_WRITE) ? "async" : "blocking";
+
+  TC_PRINT("Full redraw, %s writes, %u us rendering, %u us of pixels on the "
+           "bus\n",
+           path, RENDER_US, PIXEL_BUS_US);
+
+  for (size_t i = 0U; i < ARRAY_SIZE(stripe_rows); ++i) {
+    uint16_t rows = stripe_rows[i];
+    uint32_t stripes = DIV_ROUND_UP(SCREEN_ROWS, rows);
+    uint32_t slack_us = stripes * STRIPE_SLACK_US;
+    struct test_spi_stats stats;
+    uint32_t single_us;
+    uint32_t double_us;
+
+    single_us = redraw_us(rows, 1);
+    test_spi_reset_stats(spi);
+    double_us = redraw_us(rows, 2);
+    test_spi_get_stats(spi, &stats);
+
+    TC_PRINT("%3u rows, %2u stripes: %5u bytes, %5u us with one draw "
+             "buffer; %5u bytes, %5u us with two\n",
+             rows, stripes, rows * ROW_BYTES, single_us, 2 * rows * ROW_BYTES,
+             double_us);
+    zassert_equal(stats.pixel_bytes, SCREEN_BYTES);
+    zassert_equal(stats.errors, 0);
+
+    /* With one buffer rendering and sending always take turns */
+    zassert_true(single_us >= RENDER_US + PIXEL_BUS_US, "%u us", single_us);
+    zassert_true(single_us <= RENDER_US + PIXEL_BUS_US + slack_us,
+                 "%u rows: %u us spent outside rendering and pixels", rows,
+                 single_us);
+
+    if (IS_ENABLED(CONFIG_SSD1351_ASYNC_WRITE)) {
+      /* Only the first stripe is rendered while the bus is idle */
+      zassert_true(double_us >= PIXEL_BUS_US, "%u us", double_us);
+      zassert_true(double_us <=
+                       rows * RENDER_US_PER_ROW + PIXEL_BUS_US + slack_us,
+                   "%u rows: rendering did not overlap the transfers", rows);
+    } else {
+      /* The write blocks, so the second buffer has nothing to overlap */
+      zassert_true(double_us >= RENDER_US + PIXEL_BUS_US, "%u us", double_us);
+    }
+  }
+}
+
+ZTEST_SUITE(ssd1351_pipeline, NULL, ssd1351_pipeline_setup, NULL, NULL, NULL);
@@ -0,0 +1,173 @@
+/*
+ * Copyright (c) 2024
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <drivers/display/ssd1351.h>
+#include <zephyr/device.h>
+#include <zephyr/drivers/display.h>
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+
+#include "test_spi.h"
+
+#define MAX_AREAS 4
+#define AREA_BYTES (32 * 16 * 2)
+
+/*
+ * A window of which only SETCOLUMN or SETROW changes: that command with its
+ * two parameters and WRITERAM, 4 bytes in 4 transactions with the pixels
+ */
+#define SHARED_WINDOW_BYTES 4
+#define SHARED_WINDOW_TRANSACTIONS 4
+
+struct area {
+  uint16_t x;
+  uint16_t y;
+  uint16_t width;
+  uint16_t height;
+};
+
+/* Bus traffic of a batch, once as a write per area and once batched */
+struct batch_cost {
+  struct test_spi_stats per_area;
+  struct test_spi_stats batched;
+};
+
+static const struct device *const disp = DEVICE_DT_GET(DT_NODELABEL(ssd1351));
+static const struct device *const spi = DEVICE_DT_GET(DT_NODELABEL(test_spi));
+
+static uint8_t area_bufs[MAX_AREAS][AREA_BYTES];
+
+static void to_rects(const struct area *areas, size_t count,
+                     struct ssd1351_rect *rects) {
+  for (size_t i = 0U; i < count; ++i) {
+    rects[i] = (struct ssd1351_rect){
+        .x = areas[i].x,
+        .y = areas[i].y,
+        .desc =
+            {
+                .buf_size = AREA_BYTES,
+                .width = areas[i].width,
+                .height = areas[i].height,
+                .pitch = areas[i].width,
+            },
+        .buf = area_bufs[i],
+    };
+  }
+}
+
+static uint32_t pixel_bytes(const struct area *areas, size_t count) {
+  uint32_t bytes = 0U;
+
+  for (size_t i = 0U; i < count; ++i) {
+    bytes += areas[i].width * areas[i].height * 2U;
+  }
+
+  return bytes;
+}
+
+static void write_per_area(const struct area *areas, size_t count) {
+  struct ssd1351_rect rects[MAX_AREAS];
+
+  to_rects(areas, count, rects);
+  for (size_t i = 0U; i < count; ++i) {
+    zassert_ok(display_write(disp, rects[i].x, rects[i].y, &rects[i].desc,
+                             rects[i].buf));
+  }
+  zassert_ok(ssd1351_wait_idle(disp, K_FOREVER));
+}
+
+static void write_batched(const struct area *areas, size_t count) {
+  struct ssd1351_rect rects[MAX_AREAS];
+
+  to_rects(areas, count, rects);
+  zassert_ok(ssd1351_write_rects(disp, rects, count));
+  zassert_ok(ssd1351_wait_idle(disp, K_FOREVER));
+}
+
+/* Both start from the register cache the areas written one by one leave */
+static void measure(const char *name, const struct area *areas, size_t count,
+                    struct batch_cost *cost) {
+  write_per_area(areas, count);
+  test_spi_reset_stats(spi);
+  write_per_area(areas, count);
+  test_spi_get_stats(spi, &cost->per_area);
+
+  write_per_area(areas, count);
+  test_spi_reset_stats(spi);
+  write_batched(areas, count);
+  test_spi_get_stats(spi, &cost->batched);
+
+  TC_PRINT("%s: %u -> %u transactions, %u -> %u bytes, %u -> %u us\n", name,
+           cost->per_area.transactions, cost->batched.transactions,
+           cost->per_area.cmd_bytes + cost->per_area.data_bytes,
+           cost->batched.cmd_bytes + cost->batched.data_bytes,
+           cost->per_area.bus_us, cost->batched.bus_us);
+  zassert_equal(cost->batched.pixel_bytes, cost->per_area.pixel_bytes);
+  zassert_equal(cost->batched.errors, 0);
+}
+
+static void *ssd1351_rects_setup(void) {
+  zassert_true(device_is_ready(disp), "Display not ready");
+
+  for (size_t i = 0U; i < MAX_AREAS; ++i) {
+    for (size_t j = 0U; j < AREA_BYTES; ++j) {
+      area_bufs[i][j] = j * 3U + i;
+    }
+  }
+
+  return NULL;
+}
+
+ZTEST(ssd1351_rects, test_side_by_side) {
+  static const struct area row[] = {
+      {0, 40, 32, 16}, {32, 40, 32, 16}, {64, 40, 32, 16}, {96, 40, 32, 16}};
+  struct batch_cost cost;
+
+  /* All in the rows SETROW already holds */
+  measure("Side by side", row, ARRAY_SIZE(row), &cost);
+  zassert_equal(cost.per_area.transactions,
+                ARRAY_SIZE(row) * SHARED_WINDOW_TRANSACTIONS);
+  zassert_equal(cost.batched.transactions, SHARED_WINDOW_TRANSACTIONS,
+                "Not sent as one window");
+  zassert_equal(cost.batched.cs_cycles, SHARED_WINDOW_TRANSACTIONS);
+  zassert_equal(cost.per_area.cmd_bytes + cost.per_area.data_bytes,
+                ARRAY_SIZE(row) * SHARED_WINDOW_BYTES +
+                    pixel_bytes(row, ARRAY_SIZE(row)));
+  zassert_equal(cost.batched.cmd_bytes + cost.batched.data_bytes,
+                SHARED_WINDOW_BYTES + pixel_bytes(row, ARRAY_SIZE(row)));
+}
+
+ZTEST(ssd1351_rects, test_stacked) {
+  static const struct area column[] = {
+      {20, 0, 32, 16}, {20, 16, 32, 16}, {20, 32, 32, 16}};
+  struct batch_cost cost;
+
+  /* All in the columns SETCOLUMN already holds */
+  measure("Stacked", column, ARRAY_SIZE(column), &cost);
+  zassert_equal(cost.per_area.transactions,
+                ARRAY_SIZE(column) * SHARED_WINDOW_TRANSACTIONS);
+  zassert_equal(cost.batched.transactions, SHARED_WINDOW_TRANSACTIONS,
+                "Not sent as one window");
+  zassert_equal(cost.per_area.cmd_bytes + cost.per_area.data_bytes,
+                ARRAY_SIZE(column) * SHARED_WINDOW_BYTES +
+                    pixel_bytes(column, ARRAY_SIZE(column)));
+  zassert_equal(cost.batched.cmd_bytes + cost.batched.data_bytes,
+                SHARED_WINDOW_BYTES + pixel_bytes(column, ARRAY_SIZE(column)));
+}
+
+ZTEST(ssd1351_rects, test_apart) {
+  static const struct area apart[] = {
+      {10, 10, 32, 12}, {40, 60, 32, 16}, {0, 100, 32, 16}};
+  struct batch_cost cost;
+
+  /* Nothing to join, the batch costs what the single writes do */
+  measure("Apart", apart, ARRAY_SIZE(apart), &cost);
+  zassert_equal(cost.batched.transactions, cost.per_area.transactions);
+  zassert_equal(cost.batched.cmd_bytes + cost.batched.data_bytes,
+                cost.per_area.cmd_bytes + cost.per_area.data_bytes);
+}
+
+ZTEST_SUITE(ssd1351_rects, NULL, ssd1351_rects_setup, NULL, NULL, NULL);
@@ -0,0 +1,322 @@
+/*
+ * Copyright (c) 2024
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#define DT_DRV_COMPAT zmk_test_spi
+
+#include "test_spi.h"
+
+#include <string.h>
+
+#include <zephyr/device.h>
+#include <zephyr/drivers/gpio/gpio_emul.h>
+#include <zephyr/drivers/spi.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/util.h>
+
+/* Data bytes after this command are pixels */
+#define TEST_SPI_CMD_WRITERAM 0x5C
+
+/* D/C line of the display on the bus */
+#define TEST_SPI_DC_NODE DT_NODELABEL(ssd1351)
+
+struct test_spi_data {
+  const struct device *dev;
+  struct k_spinlock lock;
+  struct k_timer timer;
+  struct test_spi_stats stats;
+  uint64_t bus_ns;
+  /* Kept across stats resets */
+  uint32_t first_pixel_cycle;
+  /* Configuration of the last transfer, which a real controller keeps */
+  const struct spi_config *config;
+  /* Holder of the bus lock taken with SPI_LOCK_ON */
+  const struct spi_config *owner;
+  bool cs_held;
+  bool manual;
+  /* Last command byte seen */
+  uint8_t cmd;
+  /* Asynchronous transfer in flight */
+  bool busy;
+  const struct spi_buf_set *tx_bufs;
+  bool tx_cmd;
+  uint32_t tx_frequency;
+  spi_callback_t cb;
+  void *userdata;
+};
+
+static const struct device *const dc_port =
+    DEVICE_DT_GET(DT_GPIO_CTLR(TEST_SPI_DC_NODE, cmd_data_gpios));
+
+/* D/C is a plain pin on the controller: low selects command */
+static bool test_spi_dc_is_cmd(void) {
+  return gpio_emul_output_get(dc_port,
+                              DT_GPIO_PIN(TEST_SPI_DC_NODE, cmd_data_gpios)) ==
+         0;
+}
+
+static size_t test_spi_len(const struct spi_buf_set *tx) {
+  size_t len = 0U;
+
+  for (size_t i = 0U; i < tx->count; ++i) {
+    len += tx->buffers[i].len;
+  }
+
+  return len;
+}
+
+static uint32_t test_spi_time_us(const struct spi_buf_set *tx,
+                                 uint32_t frequency) {
+  return DIV_ROUND_UP((uint64_t)test_spi_len(tx) * 8U * USEC_PER_SEC,
+                      frequency);
+}
+
+/* Account for a transfer leaving the bus, spotting pixel data on the way */
+static void test_spi_consume(struct test_spi_data *data,
+                             const struct spi_buf_set *tx, bool cmd,
+                             uint32_t frequency) {
+  for (size_t i = 0U; i < tx->count; ++i) {
+    const uint8_t *buf = tx->buffers[i].buf;
+
+    for (size_t j = 0U; j < tx->buffers[i].len; ++j) {
+      if (cmd) {
+        data->cmd = buf[j];
+        data->stats.cmd_bytes++;
+        data->stats.cmd_max_frequency =
+            MAX(data->stats.cmd_max_frequency, frequency);
+        continue;
+      }
+
+      data->stats.data_bytes++;
+      if (data->cmd != TEST_SPI_CMD_WRITERAM) {
+        continue;
+      }
+      data->stats.pixel_bytes++;
+      if (data->first_pixel_cycle == 0U) {
+        data->first_pixel_cycle = k_cycle_get_32();
+      }
+    }
+  }
+
+  data->bus_ns +=
+      (uint64_t)test_spi_len(tx) * 8U * NSEC_PER_SEC / frequency;
+}
+
+/*
+ * Take the bus for a transfer. CS goes down unless the previous transfer
+ * held it, and the bus refuses anyone but the holder of its lock.
+ */
+static int test_spi_start(struct test_spi_data *data,
+                          const struct spi_config *config) {
+  if (data->busy || ((data->owner != NULL) && (data->owner != config))) {
+    data->stats.errors++;
+    return -EBUSY;
+  }
+
+  data->stats.transactions++;
+  if (!data->cs_held) {
+    data->stats.cs_cycles++;
+  }
+  if (config != data->config) {
+    data->stats.reconfigs++;
+    data->config = config;
+  }
+
+  data->cs_held = (config->operation & SPI_HOLD_ON_CS) != 0U;
+  if ((config->operation & SPI_LOCK_ON) != 0U) {
+    data->owner = config;
+  }
+
+  return 0;
+}
+
+static int test_spi_transceive(const struct device *dev,
+                               const struct spi_config *config,
+                               const struct spi_buf_set *tx_bufs,
+                               const struct spi_buf_set *rx_bufs) {
+  struct test_spi_data *data = dev->data;
+  bool cmd = test_spi_dc_is_cmd();
+  k_spinlock_key_t key;
+  int ret;
+
+  ARG_UNUSED(rx_bufs);
+
+  key = k_spin_lock(&data->lock);
+  ret = test_spi_start(data, config);
+  if ((ret == 0) && (tx_bufs != NULL)) {
+    test_spi_consume(data, tx_bufs, cmd, config->frequency);
+  }
+  k_spin_unlock(&data->lock, key);
+
+  /* Let the simulated time pass that the bytes take on the wire */
+  if ((ret == 0) && (tx_bufs != NULL)) {
+    k_busy_wait(test_spi_time_us(tx_bufs, config->frequency));
+  }
+
+  return ret;
+}
+
+/* End the transfer in flight, a failed one leaves nothing on the bus */
+static int test_spi_finish(const struct device *dev, int result) {
+  struct test_spi_data *data = dev->data;
+  k_spinlock_key_t key = k_spin_lock(&data->lock);
+  spi_callback_t cb = data->cb;
+  void *userdata = data->userdata;
+
+  if (!data->busy) {
+    k_spin_unlock(&data->lock, key);
+    return -EALREADY;
+  }
+
+  if (result == 0) {
+    test_spi_consume(data, data->tx_bufs, data->tx_cmd, data->tx_frequency);
+  }
+  data->busy = false;
+  k_spin_unlock(&data->lock, key);
+
+  cb(dev, result, userdata);
+
+  return 0;
+}
+
+static void test_spi_timer_expiry(struct k_timer *timer) {
+  struct test_spi_data *data =
+      CONTAINER_OF(timer, struct test_spi_data, timer);
+
+  (void)test_spi_finish(data->dev, 0);
+}
+
+#ifdef CONFIG_SPI_ASYNC
+static int test_spi_transceive_async(const struct device *dev,
+                                     const struct spi_config *config,
+                                     const struct spi_buf_set *tx_bufs,
+                                     const struct spi_buf_set *rx_bufs,
+                                     spi_callback_t cb, void *userdata) {
+  struct test_spi_data *data = dev->data;
+  bool cmd = test_spi_dc_is_cmd();
+  k_spinlock_key_t key;
+  int ret;
+
+  ARG_UNUSED(rx_bufs);
+
+  key = k_spin_lock(&data->lock);
+  ret = test_spi_start(data, config);
+  if (ret == 0) {
+    /* The bytes are read once the transfer completes, like DMA would */
+    data->busy = true;
+    data->tx_bufs = tx_bufs;
+    data->tx_cmd = cmd;
+    data->tx_frequency = config->frequency;
+    data->cb = cb;
+    data->userdata = userdata;
+    if (!data->manual) {
+      k_timer_start(&data->timer,
+                    K_USEC(test_spi_time_us(tx_bufs, config->frequency)),
+                    K_NO_WAIT);
+    }
+  }
+  k_spin_unlock(&data->lock, key);
+
+  return ret;
+}
+#endif
+
+/* Like most controllers, only the configuration in use can be released */
+static int test_spi_release(const struct device *dev,
+                            const struct spi_config *config) {
+  struct test_spi_data *data = dev->data;
+  k_spinlock_key_t key = k_spin_lock(&data->lock);
+  int ret = 0;
+
+  if (config != data->config) {
+    ret = -EINVAL;
+  } else if (data->busy) {
+    ret = -EBUSY;
+  } else {
+    data->owner = NULL;
+    data->cs_held = false;
+  }
+  k_spin_unlock(&data->lock, key);
+
+  return ret;
+}
+
+void test_spi_get_stats(const struct device *dev,
+                        struct test_spi_stats *stats) {
+  struct test_spi_data *data = dev->data;
+  k_spinlock_key_t key = k_spin_lock(&data->lock);
+
+  *stats = data->stats;
+  stats->bus_us = data->bus_ns / NSEC_PER_USEC;
+  k_spin_unlock(&data->lock, key);
+}
+
+void test_spi_reset_stats(const struct device *dev) {
+  struct test_spi_data *data = dev->data;
+  k_spinlock_key_t key = k_spin_lock(&data->lock);
+
+  memset(&data->stats, 0, sizeof(data->stats));
+  data->bus_ns = 0U;
+  k_spin_unlock(&data->lock, key);
+}
+
+uint32_t test_spi_first_pixel_cycle(const struct device *dev) {
+  const struct test_spi_data *data = dev->data;
+
+  return data->first_pixel_cycle;
+}
+
+void test_spi_set_manual(const struct device *dev, bool manual) {
+  struct test_spi_data *data = dev->data;
+
+  data->manual = manual;
+}
+
+bool test_spi_is_busy(const struct device *dev) {
+  const struct test_spi_data *data = dev->data;
+
+  return data->busy;
+}
+
+int test_spi_complete(const struct device *dev) {
+  struct test_spi_data *data = dev->data;
+
+  k_timer_stop(&data->timer);
+
+  return test_spi_finish(dev, 0);
+}
+
+int test_spi_fail(const struct device *dev, int result) {
+  struct test_spi_data *data = dev->data;
+
+  k_timer_stop(&data->timer);
+
+  return test_spi_finish(dev, result);
+}
+
+static const struct spi_driver_api test_spi_api = {
+    .transceive = test_spi_transceive,
+#ifdef CONFIG_SPI_ASYNC
+    .transceive_async = test_spi_transceive_async,
+#endif
+    .release = test_spi_release,
+};
+
+static int test_spi_init(const struct device *dev) {
+  struct test_spi_data *data = dev->data;
+
+  data->dev = dev;
+  k_timer_init(&data->timer, test_spi_timer_expiry, NULL);
+
+  return device_is_ready(dc_port) ? 0 : -ENODEV;
+}
+
+#define TEST_SPI_INIT(inst)                                                    \
+  static struct test_spi_data test_spi_data_##inst;                            \
+  DEVICE_DT_INST_DEFINE(inst, test_spi_init, NULL, &test_spi_data_##inst,      \
+                        NULL, POST_KERNEL, CONFIG_SPI_INIT_PRIORITY,           \
+                        &test_spi_api);
+
+DT_INST_FOREACH_STATUS_OKAY(TEST_SPI_INIT)
@@ -0,0 +1,91 @@
+/*
+ * Copyright (c) 2024
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef TEST_SPI_H__
+#define TEST_SPI_H__
+
+#include <zephyr/device.h>
+
+/** @brief Traffic seen by the test SPI controller */
+struct test_spi_stats {
+  /** spi_transceive() and spi_transceive_cb() calls */
+  uint32_t transactions;
+  /** Times CS was asserted, transfers on a held CS don't count */
+  uint32_t cs_cycles;
+  /** Transfers with another spi_config than the one before */
+  uint32_t reconfigs;
+  /** Bytes sent with D/C in command state */
+  uint32_t cmd_bytes;
+  /** Bytes sent with D/C in data state, pixel data included */
+  uint32_t data_bytes;
+  /** Data bytes following WRITERAM */
+  uint32_t pixel_bytes;
+  /** Time the bytes take on the bus at the clock they were sent with */
+  uint32_t bus_us;
+  /** Fastest clock a command byte was sent at */
+  uint32_t cmd_max_frequency;
+  /** Transfers started while another one was in flight or the bus was
+   *  locked to another spi_config
+   */
+  uint32_t errors;
+};
+
+/**
+ * @brief Read the traffic counters
+ *
+ * Bytes of an asynchronous transfer are counted when it completes.
+ */
+void test_spi_get_stats(const struct device *dev, struct test_spi_stats *stats);
+
+/**
+ * @brief Clear the traffic counters
+ */
+void test_spi_reset_stats(const struct device *dev);
+
+/**
+ * @brief Cycle count when the first pixel byte since boot went out
+ *
+ * Not cleared by test_spi_reset_stats(), so it still tells when the panel
+ * showed its first pixel after other tests ran.
+ *
+ * @retval 0 if no pixel was sent yet
+ */
+uint32_t test_spi_first_pixel_cycle(const struct device *dev);
+
+/**
+ * @brief Hold asynchronous transfers until test_spi_complete()
+ *
+ * @param manual true to complete transfers by hand, false to complete them
+ *               once their bus time has passed
+ */
+void test_spi_set_manual(const struct device *dev, bool manual);
+
+/**
+ * @brief Whether an asynchronous transfer is in flight
+ */
+bool test_spi_is_busy(const struct device *dev);
+
+/**
+ * @brief Complete the asynchronous transfer in flight
+ *
+ * @retval 0 on success
+ * @retval -EALREADY if no transfer is in flight
+ */
+int test_spi_complete(const struct device *dev);
+
+/**
+ * @brief Fail the asynchronous transfer in flight
+ *
+ * Nothing of it is counted as sent.
+ *
+ * @param result Negative errno handed to the transfer's callback
+ *
+ * @retval 0 on success
+ * @retval -EALREADY if no transfer is in flight
+ */
+int test_spi_fail(const struct device *dev, int result);
+
+#endif /* TEST_SPI_H__ */